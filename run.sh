@@ -7,6 +7,12 @@ if [ "$1" == "s" ]; then
 	LD_LIBRARY_PATH="$PWD/netsi/build/release/lib" ./build/${mode}/bin/server
 elif [ "$1" == "t" ]; then
 	./build/${mode}/tests/bin/packet_helper_test
+	./build/${mode}/tests/bin/frustum_test
+	./build/${mode}/tests/bin/arena_allocator_test
+elif [ "$1" == "b" ]; then
+	./build/${mode}/tests/bin/sheep_tick_benchmark
+	./build/${mode}/tests/bin/ray_sphere_benchmark
+	./build/${mode}/tests/bin/chunk_mesh_benchmark
 elif [ "$1" == "r" ]; then
 	LD_LIBRARY_PATH="$PWD/netsi/build/release/lib" ./build/${mode}/bin/client "generic-sauce.de" "alok"
 else
@@ -1,6 +1,7 @@
 #include "client.hpp"
 
 // #define GLM_ENABLE_EXPERIMENTAL
+#include <array>
 #include <iostream>
 
 #include "../common/networking/login_packet.hpp"
@@ -8,7 +9,10 @@
 #include "../common/networking/actions_packet.hpp"
 #include "../common/networking/packet_ids.hpp"
 
-client::client() : _network_manager(BUFFER_SIZE), _local_player_id(-1) {}
+// seconds between two actions packets, if the input did not change
+constexpr double ACTIONS_RESEND_INTERVAL = 0.02;
+
+client::client() : _network_manager(BUFFER_SIZE), _last_actions(0), _input_sequence(0), _last_actions_send_time(0.0), _local_player_id(-1) {}
 
 void client::init(const std::string& hostname, const std::string& player_name) {
 	renderer::init();
@@ -89,13 +93,25 @@ void client::send_actions_update() {
 
 	glm::vec2 mouse_changes = ctrl.poll_mouse_changes();
 
-	if (_last_actions != current_actions || mouse_changes != glm::vec2()) {
+	bool new_frame = _last_actions != current_actions || mouse_changes != glm::vec2();
+	if (new_frame) {
+		_input_frames.push_back(actions_packet::input_frame(current_actions, mouse_changes));
+		if (_input_frames.size() > NUM_REDUNDANT_INPUT_FRAMES) {
+			_input_frames.pop_front();
+		}
+		_input_sequence++;
+	}
+	_last_actions = current_actions;
+
+	// resend the last frames regularly, so lost packets are compensated
+	const double now = _renderer->get_time();
+	if (_input_sequence != 0 && (new_frame || now - _last_actions_send_time >= ACTIONS_RESEND_INTERVAL)) {
 		std::vector<char> buffer;
-		actions_packet packet(current_actions, mouse_changes);
+		actions_packet packet(_input_sequence, std::vector<actions_packet::input_frame>(_input_frames.cbegin(), _input_frames.cend()));
 		packet.write_to(&buffer);
 		_peer.send(buffer);
+		_last_actions_send_time = now;
 	}
-	_last_actions = current_actions;
 }
 
 bool client::handle_message(const std::vector<char>& buffer) {
@@ -116,19 +132,12 @@ bool client::handle_message(const std::vector<char>& buffer) {
 }
 
 void client::apply_player_info(const game_update_packet::player_info& pi) {
-	bool new_player = true;
-	for (player& p : _current_frame.players) {
-		if (p.get_id() == pi.id) {
-			p.set_position(pi.position);
-			p.set_view_angles(pi.view_angles);
-			p.set_hook(hook(pi.player_hook));
-			new_player = false;
-			break;
-		}
-	}
-
-	if (new_player) {
-		_current_frame.players.push_back(player(pi.id, "", pi.position, pi.player_hook));
+	if (player* p = _current_frame.get_player(pi.id)) {
+		p->set_position(pi.position);
+		p->set_view_angles(pi.view_angles);
+		p->set_hook(hook(pi.player_hook));
+	} else {
+		_current_frame.players.insert(player(pi.id, "", pi.position, pi.player_hook));
 	}
 }
 
@@ -139,7 +148,7 @@ void client::handle_init(const std::vector<char>& buffer) {
 	_current_frame.blocks = block_container(block_container::create_field(packet.map_seed));
 
 	for (const auto& bc : _current_frame.blocks.get_chunks()) {
-		_renderer->load_chunk(*(bc.second));
+		_renderer->mark_chunk_dirty(bc.first);
 	}
 }
 
@@ -152,54 +161,43 @@ void client::handle_game_update(const std::vector<char>& buffer) {
 }
 
 void client::handle_player_infos(const std::vector<game_update_packet::player_info>& player_infos) {
-	std::vector<char> current_player_ids;
+	std::array<bool, MAX_PLAYER_IDS> current_player_ids{};
 	for (const game_update_packet::player_info& pi : player_infos) {
 		apply_player_info(pi);
-		current_player_ids.push_back(pi.id);
+		current_player_ids[static_cast<unsigned char>(pi.id)] = true;
 	}
 
-	_current_frame.players.erase(
-		std::remove_if(
-			_current_frame.players.begin(),
-			_current_frame.players.end(),
-			[current_player_ids](const player& p) { return std::find(current_player_ids.begin(), current_player_ids.end(), p.get_id()) == current_player_ids.end(); }
-		),
-		_current_frame.players.end()
-	);
-
-	for (auto it = _current_frame.players.begin(); it != _current_frame.players.end(); ++it) {
-		bool found = false;
-		for (const auto& pi : player_infos) {
-			if (pi.id == it->get_id()) {
-				found = true;
-				break;
-			}
-		}
-		if (!found) {
-			it = _current_frame.players.erase(it);
+	// players, that are not in the update, left the game
+	std::vector<char> left_player_ids;
+	for (const player& p : _current_frame.players) {
+		if (!current_player_ids[static_cast<unsigned char>(p.get_id())]) {
+			left_player_ids.push_back(p.get_id());
 		}
 	}
+	for (char player_id : left_player_ids) {
+		_current_frame.players.erase(player_id);
+	}
 }
 
 void client::handle_sheep_infos(const std::vector<game_update_packet::sheep_info>& sis) {
 	_current_frame.sheeps.clear();
 
 	for (const game_update_packet::sheep_info& si : sis) {
-		_current_frame.sheeps.push_back(si.create_sheep());
+		si.create_sheep(&_current_frame.sheeps);
 	}
 }
 
 void client::handle_block_removes(const std::vector<glm::ivec3>& block_removes) {
 	for (const glm::ivec3& br : block_removes) {
 		_current_frame.blocks.remove_block(br);
-		_renderer->load_chunk(*_current_frame.blocks.get_containing_chunk(br));
+		_renderer->mark_block_dirty(br);
 	}
 }
 
 void client::handle_block_additions(const std::vector<glm::ivec3>& block_additions) {
 	for (const glm::ivec3& ba : block_additions) {
 		_current_frame.blocks.add_block(ba, block_type::NORMAL);
-		_renderer->load_chunk(*_current_frame.blocks.get_containing_chunk(ba));
+		_renderer->mark_block_dirty(ba);
 	}
 }
 
@@ -3,11 +3,14 @@
 
 #define GLM_ENABLE_EXPERIMENTAL
 
+#include <deque>
+
 #include <netsi/client.hpp>
 
 #include "../common/frame.hpp"
 #include "../common/networking/game_update_packet.hpp"
 #include "../common/networking/buffer_size.hpp"
+#include "../common/networking/actions_packet.hpp"
 #include "render/renderer.hpp"
 
 class client {
@@ -34,6 +37,9 @@ class client {
 		std::unique_ptr<renderer> _renderer;
 		netsi::Peer _peer;
 		std::uint16_t _last_actions;
+		std::deque<actions_packet::input_frame> _input_frames;
+		std::uint32_t _input_sequence;
+		double _last_actions_send_time;
 		char _local_player_id;
 };
 
@@ -0,0 +1,34 @@
+#include "frustum.hpp"
+
+// Extracts the planes from the rows of the matrix (Gribb/Hartmann).
+// A point p is inside, if -w <= x, y, z <= w for (x, y, z, w) = proj_view * p.
+frustum::frustum(const glm::mat4& proj_view) {
+	const glm::mat4 rows = glm::transpose(proj_view);
+	for (unsigned int axis = 0; axis < 3; axis++) {
+		_planes[2*axis] = rows[3] + rows[axis];
+		_planes[2*axis + 1] = rows[3] - rows[axis];
+	}
+	for (glm::vec4& plane : _planes) {
+		plane /= glm::length(glm::vec3(plane));
+	}
+}
+
+bool frustum::contains_box(const glm::vec3& min, const glm::vec3& max) const {
+	for (const glm::vec4& plane : _planes) {
+		// the corner of the box, that is the furthest inside of the plane
+		const glm::vec3 corner = glm::mix(min, max, glm::greaterThan(glm::vec3(plane), glm::vec3(0.f)));
+		if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool frustum::contains_sphere(const glm::vec3& center, float radius) const {
+	for (const glm::vec4& plane : _planes) {
+		if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+			return false;
+		}
+	}
+	return true;
+}
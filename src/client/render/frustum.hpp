@@ -0,0 +1,26 @@
+#ifndef __FRUSTUM_CLASS__
+#define __FRUSTUM_CLASS__
+
+#include <array>
+
+#include <glm/glm.hpp>
+
+/**
+ * The six planes of the view frustum of a projection-view matrix, used to skip draws, that are not visible.
+ * Only uses glm, so it does not need a gl context.
+ *
+ * The tests are conservative: a box or sphere is only reported as outside,
+ * if it is completely behind one of the planes.
+ */
+class frustum {
+	public:
+		explicit frustum(const glm::mat4& proj_view);
+
+		bool contains_box(const glm::vec3& min, const glm::vec3& max) const;
+		bool contains_sphere(const glm::vec3& center, float radius) const;
+	private:
+		// (normal, distance) of each plane, the normals point into the frustum
+		std::array<glm::vec4, 6> _planes;
+};
+
+#endif
@@ -14,7 +14,9 @@
 
 #include <glm/gtx/norm.hpp>
 
+#include "frustum.hpp"
 #include "shape/shape_initializer.hpp"
+#include "shape/buffer_stats.hpp"
 #include "controller/mouse_manager.hpp"
 #include "controller/resize_manager.hpp"
 #include "shaders/shaders.hpp"
@@ -22,6 +24,13 @@
 #include "../../common/physics/util.hpp"
 
 constexpr float HOOK_RENDER_STRENGTH = 0.027f;
+// the time per frame, that may be spent uploading finished chunk meshes
+constexpr double CHUNK_UPLOAD_BUDGET = 0.004;
+// the radii of spheres around the player and sheep shapes, used for frustum culling
+constexpr float PLAYER_RENDER_RADIUS = 1.f;
+constexpr float SHEEP_RENDER_RADIUS = 1.f;
+// seconds between two reports of the live gl buffers, so slow growth shows up while playing
+constexpr double BUFFER_REPORT_INTERVAL = 10.0;
 
 renderer::renderer(GLFWwindow* window, shader_program player_shader_program, shader_program sheep_shader_program, shader_program block_shader_program, shader_program hook_shader_program, shader_program visor_shader_program, unsigned int window_width, unsigned int window_height)
 	: _player_shader_program(player_shader_program),
@@ -29,8 +38,12 @@ renderer::renderer(GLFWwindow* window, shader_program player_shader_program, sha
 	  _block_shader_program(block_shader_program),
 	  _hook_shader_program(hook_shader_program),
 	  _visor_shader_program(visor_shader_program),
+	  _mesh_workers(std::make_shared<mesh_worker_pool>()),
 	  _window(window),
 	  _last_frame_time(0.0),
+	  _last_buffer_report_time(0.0),
+	  _reported_buffers(0),
+	  _reported_buffer_bytes(0),
 	  _window_width(window_width),
 	  _window_height(window_height)
 {
@@ -44,6 +57,12 @@ renderer::renderer(GLFWwindow* window, shader_program player_shader_program, sha
 	_sheep_shape = initialize::sheep();
 	_hook_shape = initialize::cube();
 	_visor_shape = initialize::visor();
+	_chunk_arena = chunk_arena::create();
+
+	// position, view angles and color of every player
+	_player_instances = instance_buffer::create(_player_shape, {shape::position_attribute, shape::position2_attribute, shape::color_attribute}, 1);
+	// position and yaw of every sheep
+	_sheep_instances = instance_buffer::create(_sheep_shape, {shape::position_attribute, shape::scalar_attribute}, 2);
 }
 
 renderer::renderer(const renderer& v)
@@ -57,6 +76,11 @@ renderer::renderer(const renderer& v)
 	  _sheep_shape(v._sheep_shape),
 	  _hook_shape(v._hook_shape),
 	  _visor_shape(v._visor_shape),
+	  _player_instances(v._player_instances),
+	  _sheep_instances(v._sheep_instances),
+	  _chunk_arena(v._chunk_arena),
+	  _mesh_workers(v._mesh_workers),
+	  _dirty_chunks(v._dirty_chunks),
 	  _window(v._window),
 	  _last_frame_time(v._last_frame_time),
 	  _window_width(v._window_width),
@@ -171,30 +195,50 @@ double renderer::get_delta_time() {
 	return delta_time;
 }
 
-void renderer::load_chunk(const block_chunk& bc) {
-	chunk_request cr(bc.get_block_types(), bc.get_origin());
-
-	_chunks_to_load.push_back(cr);
-	
+void renderer::mark_chunk_dirty(const glm::ivec3& origin) {
+	_dirty_chunks.insert(origin);
 }
 
-void renderer::load_next_chunk() {
-	if (!_chunks_to_load.empty()) {
-		chunk_request cr = _chunks_to_load.front();
-		_chunks_to_load.pop_front();
-
-		// remove old chunk
-		for (auto it = _render_chunks.begin(); it != _render_chunks.end(); ++it) {
-			if (it->origin == cr.origin) {
-				it->chunk_shape.free_buffers();
-				_render_chunks.erase(it);
-				break;
-			}
+void renderer::mark_block_dirty(const glm::ivec3& position) {
+	const glm::ivec3 origin = block_container::to_chunk_position(position);
+	mark_chunk_dirty(origin);
+
+	// the neighbor chunk culls its border faces against this block
+	const glm::ivec3 local_position = position - origin;
+	for (unsigned int axis = 0; axis < 3; axis++) {
+		glm::ivec3 neighbor_origin = origin;
+		if (local_position[axis] == 0) {
+			neighbor_origin[axis] -= BLOCK_CHUNK_SIZE;
+			mark_chunk_dirty(neighbor_origin);
+		} else if (local_position[axis] == (int)BLOCK_CHUNK_SIZE - 1) {
+			neighbor_origin[axis] += BLOCK_CHUNK_SIZE;
+			mark_chunk_dirty(neighbor_origin);
 		}
+	}
+}
 
-		render_chunk rc = do_load_chunk(cr);
-		_render_chunks.push_back(rc);
+void renderer::request_dirty_chunks(const block_container& blocks) {
+	for (const glm::ivec3& origin : _dirty_chunks) {
+		auto chunk = blocks.get_chunks().find(origin);
+		if (chunk != blocks.get_chunks().end()) {
+			_mesh_workers->request(chunk_request(chunk->second->get_block_types(), get_chunk_borders(blocks, origin), origin));
+		}
 	}
+	_dirty_chunks.clear();
+}
+
+void renderer::upload_finished_chunks() {
+	const double start_time = glfwGetTime();
+
+	// at least one mesh is uploaded per frame, so the chunks keep coming even on slow machines
+	do {
+		std::optional<mesh_worker_pool::finished_mesh> mesh = _mesh_workers->pop_finished();
+		if (!mesh) {
+			break;
+		}
+
+		_chunk_arena.upload(mesh->origin, std::move(mesh->vertices));
+	} while (glfwGetTime() - start_time < CHUNK_UPLOAD_BUDGET);
 }
 
 void renderer::render_hook(const glm::vec3& player_position, const glm::vec3& hook_tip) {
@@ -220,6 +264,7 @@ void renderer::render_hook(const glm::vec3& player_position, const glm::vec3& ho
 }
 
 void renderer::render(frame& f, char local_player_id) {
+	request_dirty_chunks(f.blocks);
 	clear_window();
 	player* local_player = f.get_player(local_player_id);
 
@@ -231,42 +276,41 @@ void renderer::render(frame& f, char local_player_id) {
 		);
 
 		glm::mat4 proj_view = projection * local_player->get_look_at();
+		const frustum view_frustum(proj_view);
 
 		// render blocks
 		_block_shader_program.use();
 		_block_shader_program.set_4fv("proj_view", proj_view);
 
-		for (const render_chunk& rc : _render_chunks) {
-			rc.chunk_shape.bind();
-			glm::mat4 model = glm::mat4(1.f);
-			model = glm::translate(model, glm::vec3(rc.origin));
-			_block_shader_program.set_4fv("model", model);
-
-			glDrawArrays(GL_TRIANGLES, 0, rc.chunk_shape.get_number_vertices());
-		}
+		_chunk_arena.draw(view_frustum, _block_shader_program);
 
 		// render players
 		_player_shader_program.use();
 		_player_shader_program.set_4fv("proj_view", proj_view);
 		_player_shader_program.set_3f("player_position", local_player->get_camera_position());
 
-		_player_shape.bind();
-
+		_player_instance_data.clear();
 		for (player& p : f.players) {
 			// dont render local player
 			if (p.get_id() == local_player_id) {
 				continue;
 			}
-			glm::mat4 model = glm::mat4(1.f);
-			model = glm::translate(model, p.get_position());
-			model = glm::rotate(model, glm::radians(p.get_view_angles().x), p.get_right());
-			model = glm::rotate(model, glm::radians(-p.get_view_angles().y), body::get_up());
-			_player_shader_program.set_4fv("model", model);
-
-			_player_shader_program.set_3f("color", p.get_color());
-
-			glDrawArrays(GL_TRIANGLES, 0, _player_shape.get_number_vertices());
+			if (!view_frustum.contains_sphere(p.get_position(), PLAYER_RENDER_RADIUS)) {
+				continue;
+			}
+			const glm::vec3& position = p.get_position();
+			const glm::vec2& view_angles = p.get_view_angles();
+			const glm::vec3 color = p.get_color();
+			_player_instance_data.insert(_player_instance_data.end(), {
+				position.x, position.y, position.z,
+				view_angles.x, view_angles.y,
+				color.r, color.g, color.b
+			});
 		}
+		_player_instances.update(_player_instance_data.data(), _player_instance_data.size() / 8);
+
+		_player_shape.bind();
+		glDrawArraysInstanced(GL_TRIANGLES, 0, _player_shape.get_number_vertices(), _player_instances.get_number_instances());
 
 		// render hooks
 		_hook_shader_program.use();
@@ -297,20 +341,43 @@ void renderer::render(frame& f, char local_player_id) {
 		_sheep_shader_program.set_4fv("proj_view", proj_view);
 		_sheep_shader_program.set_3f("player_position", local_player->get_camera_position());
 
-		_sheep_shape.bind();
+		_sheep_instance_data.clear();
 		for (const sheep& s : f.sheeps) {
-			glm::mat4 sheep_model = glm::mat4(1.f);
-			sheep_model = glm::translate(sheep_model, s.get_position());
-			sheep_model = glm::rotate(sheep_model, glm::radians(-s.get_yaw()), body::get_up());
-			_sheep_shader_program.set_4fv("model", sheep_model);
-			glDrawArrays(GL_TRIANGLES, 0, _sheep_shape.get_number_vertices());
+			if (!view_frustum.contains_sphere(s.get_position(), SHEEP_RENDER_RADIUS)) {
+				continue;
+			}
+			const glm::vec3 position = s.get_position();
+			_sheep_instance_data.insert(_sheep_instance_data.end(), {position.x, position.y, position.z, s.get_yaw()});
 		}
+		_sheep_instances.update(_sheep_instance_data.data(), _sheep_instance_data.size() / 4);
+
+		_sheep_shape.bind();
+		glDrawArraysInstanced(GL_TRIANGLES, 0, _sheep_shape.get_number_vertices(), _sheep_instances.get_number_instances());
 	}
 
 	glfwSwapBuffers(_window);
 	glfwPollEvents();
 
-	load_next_chunk();
+	upload_finished_chunks();
+	report_buffers();
+}
+
+void renderer::report_buffers() {
+	const double now = glfwGetTime();
+	if (now - _last_buffer_report_time < BUFFER_REPORT_INTERVAL) {
+		return;
+	}
+	_last_buffer_report_time = now;
+
+	// only changes are reported, a steady game stays quiet
+	const std::size_t live_buffers = buffer_stats::get_live_buffers();
+	const std::size_t live_bytes = buffer_stats::get_live_bytes();
+	if (live_buffers == _reported_buffers && live_bytes == _reported_buffer_bytes) {
+		return;
+	}
+	std::cout << "gl buffers: " << live_buffers << " alive with " << live_bytes << " bytes" << std::endl;
+	_reported_buffers = live_buffers;
+	_reported_buffer_bytes = live_bytes;
 }
 
 void renderer::close() {
@@ -321,9 +388,15 @@ void renderer::close() {
 	_sheep_shape.free_buffers();
 	_hook_shape.free_buffers();
 	_visor_shape.free_buffers();
+	_player_instances.free_buffers();
+	_sheep_instances.free_buffers();
+
+	_mesh_workers.reset();
+	_chunk_arena.free_buffers();
+	shape::free_quad_index_buffer();
 
-	for (render_chunk& rc : _render_chunks) {
-		rc.chunk_shape.free_buffers();
+	if (buffer_stats::get_live_buffers() != 0) {
+		std::cerr << "leaked " << buffer_stats::get_live_buffers() << " gl buffers with " << buffer_stats::get_live_bytes() << " bytes" << std::endl;
 	}
 
 	glfwTerminate();
@@ -1,15 +1,20 @@
 #ifndef __RENDERER_CLASS__
 #define __RENDERER_CLASS__
 
-#include <deque>
+#include <memory>
+#include <unordered_set>
 
 #include "controller/controller.hpp"
 #include "shader_program.hpp"
+#include "shape/shape.hpp"
 #include "shape/shape_loader.hpp"
+#include "shape/mesh_worker_pool.hpp"
+#include "shape/chunk_arena.hpp"
+#include "shape/instance_buffer.hpp"
 
 struct GLFWwindow;
 class frame;
-class block_chunk;
+class block_container;
 
 class renderer {
 	public:
@@ -30,8 +35,16 @@ class renderer {
 		static std::optional<renderer> create(unsigned int window_width, unsigned int window_height, const std::string& window_name);
 
 		void run_shape_loader();
-		void load_chunk(const block_chunk& bc);
-		void load_next_chunk();
+		/**
+		 * Marks the chunk to be rebuilt from its state in the next rendered frame.
+		 * A chunk is rebuilt at most once per frame, no matter how often it is marked.
+		 */
+		void mark_chunk_dirty(const glm::ivec3& origin);
+		/**
+		 * Marks the chunk containing the changed block to be rebuilt,
+		 * and the neighbor chunks, if the block is on their border.
+		 */
+		void mark_block_dirty(const glm::ivec3& position);
 		void render_hook(const glm::vec3& player_position, const glm::vec3& hook_tip);
 		void render(frame& f, char player_id);
 		void close();
@@ -47,6 +60,12 @@ class renderer {
 
 	private:
 		double get_delta_time();
+		void request_dirty_chunks(const block_container& blocks);
+		void upload_finished_chunks();
+		/**
+		 * Prints the live gl buffers and their bytes every BUFFER_REPORT_INTERVAL seconds, if they changed.
+		 */
+		void report_buffers();
 		void clear_window();
 
 		controller _controller;
@@ -60,12 +79,21 @@ class renderer {
 		shape _sheep_shape;
 		shape _hook_shape;
 		shape _visor_shape;
-		std::vector<render_chunk> _render_chunks;
-		std::deque<chunk_request> _chunks_to_load;
+		instance_buffer _player_instances;
+		instance_buffer _sheep_instances;
+		// the instance attributes are collected here every frame, to reuse the memory
+		std::vector<float> _player_instance_data;
+		std::vector<float> _sheep_instance_data;
+		chunk_arena _chunk_arena;
+		std::shared_ptr<mesh_worker_pool> _mesh_workers;
+		std::unordered_set<glm::ivec3, vec_hasher> _dirty_chunks;
 
 		GLFWwindow* _window;
 
 		double _last_frame_time;
+		double _last_buffer_report_time;
+		std::size_t _reported_buffers;
+		std::size_t _reported_buffer_bytes;
 
 		unsigned int _window_width;
 		unsigned int _window_height;
@@ -127,3 +127,9 @@ void shader_program::set_4fv(const std::string& name, const glm::mat4& mat) cons
 	int loc = get_uniform_location(name);
 	glUniformMatrix4fv(loc, 1,GL_FALSE, glm::value_ptr(mat));
 }
+
+void shader_program::set_3iv(const std::string& name, const std::vector<glm::ivec3>& values) const
+{
+	int loc = get_uniform_location(name);
+	glUniform3iv(loc, values.size(), &values[0].x);
+}
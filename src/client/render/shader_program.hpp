@@ -3,6 +3,7 @@
 
 #include <string>
 #include <optional>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -26,6 +27,7 @@ class shader_program
 		void set_3f(const std::string& name, const glm::vec3& value) const;
 		void set_4f(const std::string& name, const glm::vec4& value) const;
 		void set_4fv(const std::string& name, const glm::mat4& value) const;
+		void set_3iv(const std::string& name, const std::vector<glm::ivec3>& values) const;
 
 	private:
 		shader_program(unsigned int id);
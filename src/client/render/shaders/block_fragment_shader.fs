@@ -2,8 +2,19 @@ VISUALIZER_SHADER_STRINGIFY(
 out vec4 FragColor;
 
 in vec3 blockColor;
+in vec3 localPosition;
+flat in vec3 faceAxes;
+
+// the change of the color along each axis of a block, has to match chunk_mesher.cpp
+const mat3 SHADE = mat3(
+	0.012, 0.017, 0.019,
+	0.05, 0.05, 0.05,
+	0.015, 0.013, 0.011
+);
 
 void main() {
-	FragColor = vec4(blockColor, 1.0);
+	// merged faces span multiple blocks, the shading repeats for every block
+	vec3 block_offset = (fract(localPosition + 0.5) - 0.5) * faceAxes;
+	FragColor = vec4(blockColor + SHADE * block_offset, 1.0);
 }
 )
@@ -1,15 +1,26 @@
 VISUALIZER_SHADER_STRINGIFY(
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aColor;
+layout (location = 0) in uint aPacked;
+layout (location = 1) in vec4 aColor;
 
 out vec3 blockColor;
+out vec3 localPosition;
+flat out vec3 faceAxes;
 
-uniform mat4 model;
 uniform mat4 proj_view;
+// the origins of the chunks in the chunk arena, the size has to match MAX_CHUNK_SLOTS in chunk_arena.hpp
+uniform ivec3 chunk_origins[192];
 
 void main()
 {
-	gl_Position = proj_view * model * vec4(aPos, 1.0);
-	blockColor = aColor;
+	// 6 bits per coordinate shifted by 0.5 and 2 bits for the normal axis, has to match chunk_mesher.hpp
+	vec3 position = vec3(uvec3(aPacked, aPacked >> 6u, aPacked >> 12u) & uvec3(63u)) - 0.5;
+	float normal_axis = float((aPacked >> 18u) & 3u);
+	vec3 origin = vec3(chunk_origins[aPacked >> 20u]);
+
+	gl_Position = proj_view * vec4(origin + position, 1.0);
+	blockColor = aColor.rgb;
+	localPosition = position;
+	// the axes along the face, the shading along the normal is part of the color
+	faceAxes = vec3(notEqual(vec3(normal_axis), vec3(0.0, 1.0, 2.0)));
 }
 )
@@ -2,10 +2,10 @@ VISUALIZER_SHADER_STRINGIFY(
 out vec4 FragColor;
 
 uniform vec3 player_position;
-uniform vec3 color;
 
 in vec3 norm;
 in vec3 vertex_position;
+flat in vec3 color;
 
 void main() {
 	float transparency = clamp(distance(player_position, vertex_position)-0.2f, 0.0, 1.0);
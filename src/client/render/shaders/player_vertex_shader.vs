@@ -1,17 +1,31 @@
 VISUALIZER_SHADER_STRINGIFY(
 layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aTranslation;
+layout (location = 2) in vec2 aViewAngles;
+layout (location = 3) in vec3 aColor;
 
 out vec3 norm;
 out vec3 vertex_position;
+flat out vec3 color;
 
-uniform mat4 model;
 uniform mat4 proj_view;
-uniform vec3 player_position;
+
+// the rotation by angle around the unit vector axis, like glm::rotate
+mat3 rotation(vec3 axis, float angle) {
+	mat3 cross_matrix = mat3(0.0, axis.z, -axis.y, -axis.z, 0.0, axis.x, axis.y, -axis.x, 0.0);
+	return cos(angle) * mat3(1.0) + sin(angle) * cross_matrix + (1.0 - cos(angle)) * outerProduct(axis, axis);
+}
 
 void main()
 {
-	gl_Position = proj_view * model * vec4(aPos, 1.0);
+	// turn by the yaw and then pitch around the right vector of the player, right has to match body::update_basis
+	vec2 angles = radians(aViewAngles);
+	vec3 right = vec3(-sin(angles.y), 0.0, cos(angles.y));
+	mat3 model = rotation(right, angles.x) * rotation(vec3(0.0, 1.0, 0.0), -angles.y);
+
+	vertex_position = aTranslation + model * aPos;
+	gl_Position = proj_view * vec4(vertex_position, 1.0);
 	norm = aPos;
-	vertex_position = (model * vec4(aPos, 1.0)).xyz;
+	color = aColor;
 }
 )
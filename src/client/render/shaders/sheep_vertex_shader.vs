@@ -1,17 +1,22 @@
 VISUALIZER_SHADER_STRINGIFY(
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aColor;
+layout (location = 2) in vec3 aTranslation;
+layout (location = 3) in float aYaw;
 
 out vec3 sheepColor;
 out vec3 vertex_position;
 
-uniform mat4 model;
 uniform mat4 proj_view;
 
 void main()
 {
-	gl_Position = proj_view * model * vec4(aPos, 1.0);
+	// the rotation around the up axis by -yaw
+	float angle = radians(-aYaw);
+	mat3 model = mat3(cos(angle), 0.0, -sin(angle), 0.0, 1.0, 0.0, sin(angle), 0.0, cos(angle));
+
+	vertex_position = aTranslation + model * aPos;
+	gl_Position = proj_view * vec4(vertex_position, 1.0);
 	sheepColor = aColor;
-	vertex_position = (model * vec4(aPos, 1.0)).xyz;
 }
 )
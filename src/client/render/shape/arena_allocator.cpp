@@ -0,0 +1,85 @@
+#include "arena_allocator.hpp"
+
+#include <iterator>
+
+// ranges are at least this large
+constexpr std::size_t MIN_SIZE_CLASS = 256;
+
+arena_allocator::arena_allocator(std::size_t capacity) : _capacity(0), _used(0) {
+	grow(capacity);
+}
+
+std::optional<std::size_t> arena_allocator::allocate(std::size_t size) {
+	for (auto it = _free_ranges.begin(); it != _free_ranges.end(); ++it) {
+		if (it->second < size) {
+			continue;
+		}
+
+		const std::size_t offset = it->first;
+		const std::size_t rest = it->second - size;
+		_free_ranges.erase(it);
+		if (rest > 0) {
+			_free_ranges.emplace(offset + size, rest);
+		}
+		_used += size;
+		return offset;
+	}
+	return {};
+}
+
+void arena_allocator::free(std::size_t offset, std::size_t size) {
+	if (size == 0) {
+		return;
+	}
+	_used -= size;
+
+	auto next = _free_ranges.lower_bound(offset);
+	// merge with the free range behind
+	if (next != _free_ranges.end() && offset + size == next->first) {
+		size += next->second;
+		next = _free_ranges.erase(next);
+	}
+	// merge with the free range in front
+	if (next != _free_ranges.begin()) {
+		auto previous = std::prev(next);
+		if (previous->first + previous->second == offset) {
+			previous->second += size;
+			return;
+		}
+	}
+	_free_ranges.emplace_hint(next, offset, size);
+}
+
+void arena_allocator::grow(std::size_t new_capacity) {
+	if (new_capacity <= _capacity) {
+		return;
+	}
+	const std::size_t old_capacity = _capacity;
+	_capacity = new_capacity;
+	// free() counts the new space as freed
+	_used += new_capacity - old_capacity;
+	free(old_capacity, new_capacity - old_capacity);
+}
+
+// The classes are 1, 1.25, 1.5 and 1.75 times a power of two, so a range wastes at most a fifth,
+// a chunk keeps its range, when its mesh grows a little, and a freed range fits the meshes of similar chunks.
+std::size_t arena_allocator::get_size_class(std::size_t size) {
+	std::size_t power = MIN_SIZE_CLASS;
+	while (power * 2 <= size) {
+		power *= 2;
+	}
+	for (std::size_t quarters = 4; quarters < 8; quarters++) {
+		if (power * quarters / 4 >= size) {
+			return power * quarters / 4;
+		}
+	}
+	return power * 2;
+}
+
+std::size_t arena_allocator::get_capacity() const {
+	return _capacity;
+}
+
+std::size_t arena_allocator::get_used() const {
+	return _used;
+}
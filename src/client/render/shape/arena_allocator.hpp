@@ -0,0 +1,43 @@
+#ifndef __ARENA_ALLOCATOR_CLASS__
+#define __ARENA_ALLOCATOR_CLASS__
+
+#include <cstddef>
+#include <map>
+#include <optional>
+
+/**
+ * Hands out ranges of a buffer with a fixed capacity. Only keeps the bookkeeping, so it does not need a gl context.
+ *
+ * The free ranges are kept sorted by offset. Allocations take the first free range, that is large enough,
+ * and freed ranges are merged with their free neighbors.
+ */
+class arena_allocator {
+	public:
+		explicit arena_allocator(std::size_t capacity = 0);
+
+		/**
+		 * Returns the offset of a range of the given size, or nothing, if no free range is large enough.
+		 */
+		std::optional<std::size_t> allocate(std::size_t size);
+		void free(std::size_t offset, std::size_t size);
+
+		/**
+		 * Adds free space at the end. The allocated ranges keep their offsets.
+		 */
+		void grow(std::size_t new_capacity);
+
+		/**
+		 * Rounds the size up to the next size class, at least 256.
+		 */
+		static std::size_t get_size_class(std::size_t size);
+
+		std::size_t get_capacity() const;
+		std::size_t get_used() const;
+	private:
+		// offset -> size of the free ranges
+		std::map<std::size_t, std::size_t> _free_ranges;
+		std::size_t _capacity;
+		std::size_t _used;
+};
+
+#endif
@@ -0,0 +1,29 @@
+#include "buffer_stats.hpp"
+
+namespace buffer_stats {
+	// only the render thread creates buffers
+	std::size_t live_buffers = 0;
+	std::size_t live_bytes = 0;
+
+	void add_buffer() {
+		live_buffers++;
+	}
+
+	void remove_buffer(std::size_t size) {
+		live_buffers--;
+		live_bytes -= size;
+	}
+
+	void resize_buffer(std::size_t old_size, std::size_t new_size) {
+		live_bytes += new_size;
+		live_bytes -= old_size;
+	}
+
+	std::size_t get_live_buffers() {
+		return live_buffers;
+	}
+
+	std::size_t get_live_bytes() {
+		return live_bytes;
+	}
+}
@@ -0,0 +1,19 @@
+#ifndef __BUFFER_STATS_CLASS__
+#define __BUFFER_STATS_CLASS__
+
+#include <cstddef>
+
+/**
+ * Counts the gl buffers, that are alive, and the bytes they hold, to find leaked buffers.
+ * Every glGenBuffers, glBufferData and glDeleteBuffers of the renderer is reported here.
+ */
+namespace buffer_stats {
+	void add_buffer();
+	void remove_buffer(std::size_t size);
+	void resize_buffer(std::size_t old_size, std::size_t new_size);
+
+	std::size_t get_live_buffers();
+	std::size_t get_live_bytes();
+}
+
+#endif
@@ -0,0 +1,150 @@
+#include "chunk_arena.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include <glad/glad.h>
+
+#include "shape.hpp"
+#include "buffer_stats.hpp"
+#include "../frustum.hpp"
+#include "../shader_program.hpp"
+#include "../../../common/world/block_container.hpp"
+
+// about 40 chunks with the current meshes, the arena doubles, when it is full
+constexpr std::size_t INITIAL_ARENA_VERTICES = 1 << 16;
+constexpr unsigned int SLOT_SHIFT = 20;
+
+const std::vector<attribute> CHUNK_ATTRIBUTES = {shape::packed_attribute, shape::normalized_color_attribute};
+
+chunk_arena::chunk_arena()
+	: _vertex_array_object(0),
+	  _vertex_buffer_object(0),
+	  _slot_origins_changed(false)
+{}
+
+chunk_arena chunk_arena::create() {
+	chunk_arena arena;
+	glGenVertexArrays(1, &arena._vertex_array_object);
+	arena.grow(INITIAL_ARENA_VERTICES);
+
+	// the slots are handed out from the lowest
+	for (unsigned int slot = MAX_CHUNK_SLOTS; slot > 0; slot--) {
+		arena._free_slots.push_back(slot - 1);
+	}
+	return arena;
+}
+
+void chunk_arena::upload(const glm::ivec3& origin, std::vector<chunk_vertex> vertices) {
+	auto it = _chunks.find(origin);
+	if (it == _chunks.end()) {
+		if (_free_slots.empty()) {
+			std::cerr << "chunk_arena: no free slot for chunk at " << origin.x << ", " << origin.y << ", " << origin.z << std::endl;
+			return;
+		}
+		arena_chunk chunk{0, 0, 0, _free_slots.back()};
+		_free_slots.pop_back();
+
+		if (_slot_origins.size() <= chunk.slot) {
+			_slot_origins.resize(chunk.slot + 1);
+		}
+		_slot_origins[chunk.slot] = origin;
+		_slot_origins_changed = true;
+
+		it = _chunks.emplace(origin, chunk).first;
+	}
+	arena_chunk& chunk = it->second;
+
+	// keep the range, if the new mesh fits, so small edits dont move the chunk
+	if (vertices.size() > chunk.capacity) {
+		_allocator.free(chunk.offset, chunk.capacity);
+		const std::size_t capacity = arena_allocator::get_size_class(vertices.size());
+		std::optional<std::size_t> offset = _allocator.allocate(capacity);
+		if (!offset) {
+			grow(_allocator.get_capacity() + capacity);
+			offset = _allocator.allocate(capacity);
+		}
+		chunk.offset = *offset;
+		chunk.capacity = capacity;
+	}
+	chunk.number_quads = vertices.size() / 4;
+
+	for (chunk_vertex& vertex : vertices) {
+		vertex.position |= chunk.slot << SLOT_SHIFT;
+	}
+
+	glBindVertexArray(_vertex_array_object);
+	shape::bind_quad_indices(chunk.number_quads);
+	glBindBuffer(GL_ARRAY_BUFFER, _vertex_buffer_object);
+	glBufferSubData(GL_ARRAY_BUFFER, chunk.offset * sizeof(chunk_vertex), vertices.size() * sizeof(chunk_vertex), vertices.data());
+}
+
+void chunk_arena::draw(const frustum& view_frustum, const shader_program& block_shader_program) {
+	if (_slot_origins_changed) {
+		block_shader_program.set_3iv("chunk_origins", _slot_origins);
+		_slot_origins_changed = false;
+	}
+
+	_draw_counts.clear();
+	_draw_base_vertices.clear();
+	for (const auto& entry : _chunks) {
+		const arena_chunk& chunk = entry.second;
+		// the faces of the blocks are 0.5 around the block positions
+		const glm::vec3 chunk_min = glm::vec3(entry.first) - 0.5f;
+		if (chunk.number_quads == 0 || !view_frustum.contains_box(chunk_min, chunk_min + static_cast<float>(BLOCK_CHUNK_SIZE))) {
+			continue;
+		}
+		_draw_counts.push_back(6 * chunk.number_quads);
+		_draw_base_vertices.push_back(chunk.offset);
+	}
+	// all chunks start at the first quad of the shared index buffer
+	_draw_index_offsets.resize(_draw_counts.size(), nullptr);
+
+	if (_draw_counts.empty()) {
+		return;
+	}
+	glBindVertexArray(_vertex_array_object);
+	glMultiDrawElementsBaseVertex(
+		GL_TRIANGLES,
+		_draw_counts.data(),
+		GL_UNSIGNED_INT,
+		_draw_index_offsets.data(),
+		_draw_counts.size(),
+		_draw_base_vertices.data()
+	);
+}
+
+void chunk_arena::free_buffers() {
+	glDeleteVertexArrays(1, &_vertex_array_object);
+	glDeleteBuffers(1, &_vertex_buffer_object);
+	buffer_stats::remove_buffer(_allocator.get_capacity() * sizeof(chunk_vertex));
+	_chunks.clear();
+}
+
+// Moves the meshes into a larger vertex buffer and points the vao to it.
+void chunk_arena::grow(std::size_t min_capacity) {
+	std::size_t new_capacity = std::max<std::size_t>(_allocator.get_capacity(), INITIAL_ARENA_VERTICES);
+	while (new_capacity < min_capacity) {
+		new_capacity *= 2;
+	}
+
+	unsigned int new_vertex_buffer_object;
+	glGenBuffers(1, &new_vertex_buffer_object);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, new_vertex_buffer_object);
+	glBufferData(GL_COPY_WRITE_BUFFER, new_capacity * sizeof(chunk_vertex), nullptr, GL_DYNAMIC_DRAW);
+	buffer_stats::add_buffer();
+	buffer_stats::resize_buffer(0, new_capacity * sizeof(chunk_vertex));
+
+	if (_vertex_buffer_object != 0) {
+		glBindBuffer(GL_COPY_READ_BUFFER, _vertex_buffer_object);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, _allocator.get_capacity() * sizeof(chunk_vertex));
+		glDeleteBuffers(1, &_vertex_buffer_object);
+		buffer_stats::remove_buffer(_allocator.get_capacity() * sizeof(chunk_vertex));
+	}
+	_vertex_buffer_object = new_vertex_buffer_object;
+	_allocator.grow(new_capacity);
+
+	glBindVertexArray(_vertex_array_object);
+	glBindBuffer(GL_ARRAY_BUFFER, _vertex_buffer_object);
+	shape::create_attribute_pointer(CHUNK_ATTRIBUTES);
+}
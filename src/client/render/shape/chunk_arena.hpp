@@ -0,0 +1,75 @@
+#ifndef __CHUNK_ARENA_CLASS__
+#define __CHUNK_ARENA_CLASS__
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include "arena_allocator.hpp"
+#include "chunk_mesher.hpp"
+#include "../../../common/physics/vec_hasher.hpp"
+
+class frustum;
+class shader_program;
+
+/**
+ * The number of chunks, that can be in the arena at once. Has to match block_vertex_shader.vs.
+ * The slot of a chunk is stored in the highest bits of its vertices.
+ */
+constexpr unsigned int MAX_CHUNK_SLOTS = 192;
+
+/**
+ * Holds the meshes of all chunks in one vertex buffer, so all visible chunks are drawn with one draw call.
+ *
+ * Every chunk takes a range of the vertex buffer and a slot, that holds its origin in the block shader.
+ * The ranges are rounded up to size classes. Replacing the mesh of a chunk only rewrites its range, if the new mesh fits into it,
+ * otherwise the range is returned to the free list and a larger one is taken.
+ * Like shape, copies refer to the same buffers, which have to be freed with free_buffers.
+ */
+class chunk_arena {
+	public:
+		chunk_arena();
+
+		/**
+		 * Creates the vertex buffer and vao of a new arena. Needs the gl context.
+		 */
+		static chunk_arena create();
+
+		/**
+		 * Replaces the mesh of the chunk at origin with the given quads, 4 vertices per quad.
+		 */
+		void upload(const glm::ivec3& origin, std::vector<chunk_vertex> vertices);
+
+		/**
+		 * Draws all chunks, whose blocks are in the frustum. The block shader program has to be in use.
+		 */
+		void draw(const frustum& view_frustum, const shader_program& block_shader_program);
+
+		void free_buffers();
+	private:
+		struct arena_chunk {
+			std::size_t offset; // in vertices
+			std::size_t capacity; // in vertices
+			std::size_t number_quads;
+			unsigned int slot;
+		};
+
+		void grow(std::size_t min_capacity);
+
+		unsigned int _vertex_array_object;
+		unsigned int _vertex_buffer_object;
+		arena_allocator _allocator;
+
+		std::unordered_map<glm::ivec3, arena_chunk, vec_hasher> _chunks;
+		std::vector<unsigned int> _free_slots;
+		std::vector<glm::ivec3> _slot_origins;
+		bool _slot_origins_changed;
+
+		// the arguments of the multi draw call, reused every frame
+		std::vector<int> _draw_counts;
+		std::vector<int> _draw_base_vertices;
+		std::vector<const void*> _draw_index_offsets;
+};
+
+#endif
@@ -0,0 +1,246 @@
+#include "chunk_mesher.hpp"
+
+#include <iostream>
+#include <cmath>
+#include <glm/glm.hpp>
+
+#include "../../../common/world/block_container.hpp"
+
+// faces with colors closer than this are merged in GREEDY_TOLERANCE mode
+constexpr float COLOR_TOLERANCE = 0.006f;
+constexpr float GROUND_COLOR = 0.02f;
+constexpr unsigned int POSITION_BITS = 6;
+constexpr std::uint32_t POSITION_MASK = (1u << POSITION_BITS) - 1;
+
+// the change of the color along each axis of a block, has to match block_fragment_shader.fs
+const glm::vec3 SHADE[3] = {
+	glm::vec3(0.012f, 0.017f, 0.019f),
+	glm::vec3(0.05f, 0.05f, 0.05f),
+	glm::vec3(0.015f, 0.013f, 0.011f)
+};
+
+struct chunk_face {
+	block_type type; // VOID, if there is no visible face
+	glm::vec3 color;
+};
+
+// The colors of normal blocks only depend on x and z, so they are computed once per column.
+class chunk_colors {
+	public:
+		chunk_colors(const glm::ivec3& origin)
+			: _origin(origin), _normal_colors(BLOCK_CHUNK_SIZE*BLOCK_CHUNK_SIZE), _has_normal_color(BLOCK_CHUNK_SIZE*BLOCK_CHUNK_SIZE, false)
+		{}
+
+		glm::vec3 get(block_type bt, const glm::ivec3& position) {
+			switch (bt) {
+				case block_type::GROUND:
+					return glm::vec3(GROUND_COLOR);
+				case block_type::NORMAL: {
+					const unsigned int column = position.x*BLOCK_CHUNK_SIZE + position.z;
+					if (!_has_normal_color[column]) {
+						_normal_colors[column] = block_container::get_color(position + _origin);
+						_has_normal_color[column] = true;
+					}
+					return _normal_colors[column];
+				}
+				case block_type::WINNING:
+					return block_container::get_winning_color(position + _origin);
+				default:
+					std::cerr << "chunk_mesher: cant indentify block type" << std::endl;
+					return glm::vec3();
+			}
+		}
+	private:
+		glm::ivec3 _origin;
+		std::vector<glm::vec3> _normal_colors;
+		std::vector<bool> _has_normal_color;
+};
+
+unsigned int get_block_index(const glm::ivec3& position) {
+	return position.x*BLOCK_CHUNK_SIZE*BLOCK_CHUNK_SIZE + position.y*BLOCK_CHUNK_SIZE + position.z;
+}
+
+unsigned int get_border_index(unsigned int axis, int direction) {
+	return 2*axis + (direction > 0 ? 1 : 0);
+}
+
+bool face_visible(const glm::ivec3& position, unsigned int axis, int direction, const std::vector<block_type>& blocks, const chunk_borders& borders) {
+	glm::ivec3 neighbor_position = position;
+	neighbor_position[axis] += direction;
+
+	// if border of chunk, look into the touching layer of the neighbor chunk
+	if (neighbor_position[axis] < 0 || neighbor_position[axis] >= (int)BLOCK_CHUNK_SIZE) {
+		const std::vector<block_type>& border = borders[get_border_index(axis, direction)];
+		if (border.empty()) {
+			return true;
+		}
+		return border[position[(axis + 1) % 3]*BLOCK_CHUNK_SIZE + position[(axis + 2) % 3]] == block_type::VOID;
+	}
+
+	// only visible if neighbor is void block
+	return blocks[get_block_index(neighbor_position)] == block_type::VOID;
+}
+
+bool can_merge(const chunk_face& a, const chunk_face& b, mesh_mode mode) {
+	if (a.type != b.type) {
+		return false;
+	}
+	switch (mode) {
+		case mesh_mode::GREEDY_EXACT:
+			return a.color == b.color;
+		case mesh_mode::GREEDY_TOLERANCE:
+			return glm::all(glm::lessThanEqual(glm::abs(a.color - b.color), glm::vec3(COLOR_TOLERANCE)));
+		default:
+			return false;
+	}
+}
+
+std::uint8_t to_normalized_byte(float value) {
+	return static_cast<std::uint8_t>(std::round(glm::clamp(value, 0.f, 1.f) * 255.f));
+}
+
+void add_vertex(const glm::vec3& position, const glm::vec3& color, unsigned int axis, std::vector<chunk_vertex>* vertices) {
+	chunk_vertex vertex;
+	vertex.position = axis << (3*POSITION_BITS);
+	for (unsigned int i = 0; i < 3; i++) {
+		vertex.position |= static_cast<std::uint32_t>(position[i] + 0.5f) << (i*POSITION_BITS);
+		vertex.color[i] = to_normalized_byte(color[i]);
+	}
+	vertex.color[3] = 0;
+	vertices->push_back(vertex);
+}
+
+/*
+ * Adds the quad covering the faces [u, u+u_size) x [v, v+v_size) of the given slice.
+ * The color is the color at the center of the face, the shading along the face is done in the shader.
+ */
+void add_quad(
+	unsigned int axis, int direction, unsigned int slice,
+	unsigned int u, unsigned int v, unsigned int u_size, unsigned int v_size,
+	const glm::vec3& color, std::vector<chunk_vertex>* vertices
+) {
+	const unsigned int u_axis = (axis + 1) % 3;
+	const unsigned int v_axis = (axis + 2) % 3;
+	const glm::vec3 face_color = color + SHADE[axis]*(direction*0.5f);
+
+	glm::vec3 corners[4];
+	for (glm::vec3& corner : corners) {
+		corner[axis] = slice + direction*0.5f;
+	}
+	corners[0][u_axis] = u - 0.5f;          corners[0][v_axis] = v - 0.5f;
+	corners[1][u_axis] = u + u_size - 0.5f; corners[1][v_axis] = v - 0.5f;
+	corners[2][u_axis] = u + u_size - 0.5f; corners[2][v_axis] = v + v_size - 0.5f;
+	corners[3][u_axis] = u - 0.5f;          corners[3][v_axis] = v + v_size - 0.5f;
+
+	for (const glm::vec3& corner : corners) {
+		add_vertex(corner, face_color, axis, vertices);
+	}
+}
+
+// Merges the faces of one slice row by row. A quad grows along v first and then along u,
+// as long as the whole next row of faces can be merged with its first face.
+void add_slice_quads(std::vector<chunk_face>* faces, unsigned int axis, int direction, unsigned int slice, mesh_mode mode, std::vector<chunk_vertex>* vertices) {
+	for (unsigned int u = 0; u < BLOCK_CHUNK_SIZE; u++) {
+		for (unsigned int v = 0; v < BLOCK_CHUNK_SIZE; v++) {
+			const chunk_face first = (*faces)[u*BLOCK_CHUNK_SIZE + v];
+			if (first.type == block_type::VOID) continue;
+
+			unsigned int v_size = 1;
+			while (v + v_size < BLOCK_CHUNK_SIZE && can_merge(first, (*faces)[u*BLOCK_CHUNK_SIZE + v + v_size], mode)) {
+				v_size++;
+			}
+
+			unsigned int u_size = 1;
+			for (; u + u_size < BLOCK_CHUNK_SIZE; u_size++) {
+				bool row_mergeable = true;
+				for (unsigned int i = 0; i < v_size && row_mergeable; i++) {
+					row_mergeable = can_merge(first, (*faces)[(u + u_size)*BLOCK_CHUNK_SIZE + v + i], mode);
+				}
+				if (!row_mergeable) break;
+			}
+
+			add_quad(axis, direction, slice, u, v, u_size, v_size, first.color, vertices);
+
+			for (unsigned int i = 0; i < u_size; i++) {
+				for (unsigned int j = 0; j < v_size; j++) {
+					(*faces)[(u + i)*BLOCK_CHUNK_SIZE + v + j].type = block_type::VOID;
+				}
+			}
+		}
+	}
+}
+
+chunk_borders get_chunk_borders(const block_container& blocks, const glm::ivec3& origin) {
+	chunk_borders borders;
+	for (unsigned int axis = 0; axis < 3; axis++) {
+		const unsigned int u_axis = (axis + 1) % 3;
+		const unsigned int v_axis = (axis + 2) % 3;
+		for (int direction : {-1, 1}) {
+			glm::ivec3 neighbor_origin = origin;
+			neighbor_origin[axis] += direction*(int)BLOCK_CHUNK_SIZE;
+			auto neighbor = blocks.get_chunks().find(neighbor_origin);
+			if (neighbor == blocks.get_chunks().end()) {
+				continue;
+			}
+
+			// the layer of the neighbor, that touches this chunk
+			std::vector<block_type>& border = borders[get_border_index(axis, direction)];
+			border.resize(BLOCK_CHUNK_SIZE*BLOCK_CHUNK_SIZE);
+			glm::uvec3 position;
+			position[axis] = direction > 0 ? 0 : BLOCK_CHUNK_SIZE - 1;
+			for (unsigned int u = 0; u < BLOCK_CHUNK_SIZE; u++) {
+				position[u_axis] = u;
+				for (unsigned int v = 0; v < BLOCK_CHUNK_SIZE; v++) {
+					position[v_axis] = v;
+					border[u*BLOCK_CHUNK_SIZE + v] = neighbor->second->get_local_block_type(position);
+				}
+			}
+		}
+	}
+	return borders;
+}
+
+glm::vec3 get_chunk_vertex_position(const chunk_vertex& vertex) {
+	glm::vec3 position;
+	for (unsigned int i = 0; i < 3; i++) {
+		position[i] = static_cast<float>((vertex.position >> (i*POSITION_BITS)) & POSITION_MASK) - 0.5f;
+	}
+	return position;
+}
+
+std::vector<chunk_vertex> build_chunk_mesh(const std::vector<block_type>& blocks, const chunk_borders& borders, const glm::ivec3& origin, mesh_mode mode) {
+	std::vector<chunk_vertex> vertices;
+	chunk_colors colors(origin);
+	std::vector<chunk_face> faces(BLOCK_CHUNK_SIZE*BLOCK_CHUNK_SIZE);
+
+	for (unsigned int axis = 0; axis < 3; axis++) {
+		const unsigned int u_axis = (axis + 1) % 3;
+		const unsigned int v_axis = (axis + 2) % 3;
+		for (int direction : {-1, 1}) {
+			for (unsigned int slice = 0; slice < BLOCK_CHUNK_SIZE; slice++) {
+				// collect the visible faces of this slice, that point into direction
+				glm::ivec3 position;
+				position[axis] = slice;
+				for (unsigned int u = 0; u < BLOCK_CHUNK_SIZE; u++) {
+					position[u_axis] = u;
+					for (unsigned int v = 0; v < BLOCK_CHUNK_SIZE; v++) {
+						position[v_axis] = v;
+						chunk_face& face = faces[u*BLOCK_CHUNK_SIZE + v];
+						face.type = blocks[get_block_index(position)];
+						if (face.type != block_type::VOID) {
+							if (face_visible(position, axis, direction, blocks, borders)) {
+								face.color = colors.get(face.type, position);
+							} else {
+								face.type = block_type::VOID;
+							}
+						}
+					}
+				}
+
+				add_slice_quads(&faces, axis, direction, slice, mode, &vertices);
+			}
+		}
+	}
+
+	return vertices;
+}
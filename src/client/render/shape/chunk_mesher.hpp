@@ -0,0 +1,65 @@
+#ifndef __CHUNK_MESHER_CLASS__
+#define __CHUNK_MESHER_CLASS__
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <glm/vec3.hpp>
+
+#include "../../../common/world/world_block.hpp"
+
+class block_container;
+
+/**
+ * Defines how the visible faces of a chunk are turned into quads.
+ */
+enum class mesh_mode {
+	PER_FACE,         // one quad for every visible block face
+	GREEDY_EXACT,     // coplanar faces of the same block type and color are merged into larger quads
+	GREEDY_TOLERANCE  // like GREEDY_EXACT, but colors may differ a little, the quad takes the color of its first face
+};
+
+/**
+ * A vertex of a chunk mesh, decoded in block_vertex_shader.vs.
+ *
+ * The corners of the blocks are at half coordinates in [-0.5, 31.5] relative to the chunk origin.
+ * position holds each coordinate + 0.5 in 6 bits (x in the lowest bits, then y and z)
+ * followed by the axis of the face normal in 2 bits. The remaining 12 bits hold the slot of the chunk,
+ * that is set by chunk_arena on upload.
+ * The color is stored as normalized bytes, the fourth byte is unused.
+ */
+struct chunk_vertex {
+	std::uint32_t position;
+	std::uint8_t color[4];
+};
+static_assert(sizeof(chunk_vertex) == 8, "chunk vertices are uploaded tightly packed");
+
+/**
+ * Returns the position of the vertex relative to the chunk origin.
+ */
+glm::vec3 get_chunk_vertex_position(const chunk_vertex& vertex);
+
+/**
+ * The layers of blocks of the six neighbor chunks, that touch a chunk.
+ * The layer in direction d along axis a is at index 2*a + (d > 0). Its blocks are indexed by u*BLOCK_CHUNK_SIZE + v,
+ * where u and v are the local coordinates along the axes (a+1)%3 and (a+2)%3.
+ * An empty layer means, that there is no neighbor chunk, so the faces on that border are visible.
+ */
+using chunk_borders = std::array<std::vector<block_type>, 6>;
+
+/**
+ * Copies the layers of the neighbor chunks of the chunk at origin, that touch it.
+ */
+chunk_borders get_chunk_borders(const block_container& blocks, const glm::ivec3& origin);
+
+/**
+ * Builds the vertices of the mesh of one chunk. The positions are relative to the origin of the chunk.
+ * Every quad has four vertices in order around the quad, so the mesh has to be drawn with the quad indices of shape.
+ * Faces on the border of the chunk are hidden, if the touching block of the neighbor chunk is not void.
+ *
+ * Only runs on the cpu, so it does not need a gl context.
+ * The shading along a face is added in the block shader, so merged faces look like the single faces.
+ */
+std::vector<chunk_vertex> build_chunk_mesh(const std::vector<block_type>& blocks, const chunk_borders& borders, const glm::ivec3& origin, mesh_mode mode);
+
+#endif
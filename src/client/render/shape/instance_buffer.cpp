@@ -0,0 +1,47 @@
+#include "instance_buffer.hpp"
+
+#include <algorithm>
+
+#include <glad/glad.h>
+
+#include "buffer_stats.hpp"
+
+instance_buffer::instance_buffer()
+	: _buffer_object(0), _stride(0), _capacity(0), _number_instances(0)
+{}
+
+instance_buffer instance_buffer::create(const shape& s, const std::vector<attribute>& attributes, unsigned int first_location) {
+	instance_buffer ib;
+	ib._stride = shape::get_attributes_stride(attributes);
+
+	s.bind();
+	glGenBuffers(1, &ib._buffer_object);
+	buffer_stats::add_buffer();
+	glBindBuffer(GL_ARRAY_BUFFER, ib._buffer_object);
+	shape::create_attribute_pointer(attributes, first_location, 1);
+	shape::unbind();
+
+	return ib;
+}
+
+void instance_buffer::update(const void* instances, std::size_t number_instances) {
+	const std::size_t size = number_instances * _stride;
+	glBindBuffer(GL_ARRAY_BUFFER, _buffer_object);
+	if (size > _capacity) {
+		const std::size_t new_capacity = std::max(size, 2 * _capacity);
+		glBufferData(GL_ARRAY_BUFFER, new_capacity, nullptr, GL_STREAM_DRAW);
+		buffer_stats::resize_buffer(_capacity, new_capacity);
+		_capacity = new_capacity;
+	}
+	glBufferSubData(GL_ARRAY_BUFFER, 0, size, instances);
+	_number_instances = number_instances;
+}
+
+std::size_t instance_buffer::get_number_instances() const {
+	return _number_instances;
+}
+
+void instance_buffer::free_buffers() {
+	glDeleteBuffers(1, &_buffer_object);
+	buffer_stats::remove_buffer(_capacity);
+}
@@ -0,0 +1,38 @@
+#ifndef __INSTANCE_BUFFER_CLASS__
+#define __INSTANCE_BUFFER_CLASS__
+
+#include <vector>
+
+#include "shape.hpp"
+
+/**
+ * Holds per-instance attributes of a shape, so all instances are drawn with one glDrawArraysInstanced.
+ * The buffer is attached to the vao of the shape and grows, when more instances are uploaded.
+ * Like shape, copies refer to the same buffer, which has to be freed with free_buffers.
+ */
+class instance_buffer {
+	public:
+		instance_buffer();
+
+		/**
+		 * Creates the buffer and attaches the attributes to the vao of the given shape.
+		 *
+		 * @param first_location The location of the first instance attribute, it has to follow the vertex attributes of the shape.
+		 */
+		static instance_buffer create(const shape& s, const std::vector<attribute>& attributes, unsigned int first_location);
+
+		/**
+		 * Replaces the instances. The attributes of an instance are tightly packed.
+		 */
+		void update(const void* instances, std::size_t number_instances);
+		std::size_t get_number_instances() const;
+
+		void free_buffers();
+	private:
+		unsigned int _buffer_object;
+		std::size_t _stride;
+		std::size_t _capacity; // in bytes
+		std::size_t _number_instances;
+};
+
+#endif
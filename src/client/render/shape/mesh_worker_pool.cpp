@@ -0,0 +1,89 @@
+#include "mesh_worker_pool.hpp"
+
+#include <algorithm>
+
+#include "chunk_mesher.hpp"
+
+mesh_worker_pool::mesh_worker_pool(unsigned int num_threads) : _stop(false) {
+	if (num_threads == 0) {
+		// leave one hardware thread to the render thread
+		num_threads = std::max(2u, std::thread::hardware_concurrency()) - 1;
+	}
+	for (unsigned int i = 0; i < num_threads; i++) {
+		_workers.push_back(std::thread(&mesh_worker_pool::worker_loop, this));
+	}
+}
+
+mesh_worker_pool::~mesh_worker_pool() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_jobs_condition.notify_all();
+	for (std::thread& t : _workers) {
+		t.join();
+	}
+}
+
+void mesh_worker_pool::request(const chunk_request& cr) {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		++_latest_versions[cr.origin];
+
+		auto queued = _queued_requests.find(cr.origin);
+		if (queued != _queued_requests.end()) {
+			queued->second = cr;
+			return;
+		}
+		_queued_requests.emplace(cr.origin, cr);
+		_queued_origins.push_back(cr.origin);
+	}
+	_jobs_condition.notify_one();
+}
+
+std::optional<mesh_worker_pool::finished_mesh> mesh_worker_pool::pop_finished() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	while (!_finished.empty()) {
+		versioned_mesh vm = std::move(_finished.front());
+		_finished.pop_front();
+		if (is_latest(vm.mesh.origin, vm.version)) {
+			return std::move(vm.mesh);
+		}
+	}
+	return {};
+}
+
+void mesh_worker_pool::worker_loop() {
+	while (true) {
+		chunk_request cr;
+		std::uint64_t version;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_jobs_condition.wait(lock, [this]{ return _stop || !_queued_origins.empty(); });
+			if (_stop) {
+				return;
+			}
+			auto queued = _queued_requests.find(_queued_origins.front());
+			_queued_origins.pop_front();
+
+			cr = std::move(queued->second);
+			_queued_requests.erase(queued);
+			// a queued request is always the latest one of its chunk
+			version = _latest_versions[cr.origin];
+		}
+
+		std::vector<chunk_vertex> vertices = build_chunk_mesh(cr.blocks, cr.borders, cr.origin, mesh_mode::GREEDY_TOLERANCE);
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		// a newer version was requested, while the mesh was built
+		if (is_latest(cr.origin, version)) {
+			_finished.push_back(versioned_mesh{finished_mesh{cr.origin, std::move(vertices)}, version});
+		}
+	}
+}
+
+// has to be called with _mutex locked
+bool mesh_worker_pool::is_latest(const glm::ivec3& origin, std::uint64_t version) const {
+	auto it = _latest_versions.find(origin);
+	return it != _latest_versions.end() && it->second == version;
+}
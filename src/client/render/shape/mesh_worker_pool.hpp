@@ -0,0 +1,71 @@
+#ifndef __MESH_WORKER_POOL_CLASS__
+#define __MESH_WORKER_POOL_CLASS__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include "shape_loader.hpp"
+#include "../../../common/physics/vec_hasher.hpp"
+
+/**
+ * Builds chunk meshes on background threads, so the render thread only has to upload them.
+ *
+ * Every request gets a new version of its chunk. A queued request replaces the older queued request of its chunk,
+ * and meshes of older versions, that are built or finished already, are dropped.
+ * So only the latest mesh of a chunk is ever uploaded.
+ */
+class mesh_worker_pool {
+	public:
+		struct finished_mesh {
+			glm::ivec3 origin;
+			std::vector<chunk_vertex> vertices;
+		};
+
+		/**
+		 * @param num_threads The number of worker threads. 0 uses one thread per hardware thread except the render thread.
+		 */
+		explicit mesh_worker_pool(unsigned int num_threads = 0);
+		~mesh_worker_pool();
+
+		mesh_worker_pool(const mesh_worker_pool&) = delete;
+		mesh_worker_pool& operator=(const mesh_worker_pool&) = delete;
+
+		/**
+		 * Queues the mesh of the given chunk to be built. Older requests for the same chunk are cancelled.
+		 * If an older request is still queued, the new request takes its place in the queue.
+		 */
+		void request(const chunk_request& cr);
+
+		/**
+		 * Returns a finished mesh, that is still the latest version of its chunk, if there is one.
+		 */
+		std::optional<finished_mesh> pop_finished();
+	private:
+		struct versioned_mesh {
+			finished_mesh mesh;
+			std::uint64_t version;
+		};
+
+		void worker_loop();
+		bool is_latest(const glm::ivec3& origin, std::uint64_t version) const;
+
+		std::vector<std::thread> _workers;
+		// the origins of the queued requests in request order, every origin is queued at most once
+		std::deque<glm::ivec3> _queued_origins;
+		std::unordered_map<glm::ivec3, chunk_request, vec_hasher> _queued_requests;
+		std::deque<versioned_mesh> _finished;
+		std::unordered_map<glm::ivec3, std::uint64_t, vec_hasher> _latest_versions;
+		std::mutex _mutex;
+		std::condition_variable _jobs_condition;
+		bool _stop;
+};
+
+#endif
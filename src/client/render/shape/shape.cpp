@@ -1,48 +1,70 @@
 #include "shape.hpp"
 
+#include <algorithm>
+#include <cstdint>
+
 #include <glad/glad.h>
 
+#include "buffer_stats.hpp"
+
+const attribute shape::scalar_attribute(1, GL_FLOAT);
 const attribute shape::position_attribute(3, GL_FLOAT);
 const attribute shape::position2_attribute(2, GL_FLOAT);
 const attribute shape::color_attribute(3, GL_FLOAT);
 const attribute shape::texture_coordinate_attribute(2, GL_FLOAT);
 const attribute shape::normale_attribute(3, GL_FLOAT);
+const attribute shape::packed_attribute(1, GL_UNSIGNED_INT, false, true);
+const attribute shape::normalized_color_attribute(4, GL_UNSIGNED_BYTE, true);
+
+unsigned int shape::_quad_index_buffer = 0;
+std::size_t shape::_quad_index_buffer_quads = 0;
+
+// the quad index buffer holds at least this many quads, so small chunk meshes dont grow it step by step
+constexpr std::size_t MIN_QUAD_INDEX_BUFFER_QUADS = 4096;
 
 shape::shape(unsigned int vertex_array_object,
 			 unsigned int vertex_buffer_object,
-			 n_vertices number_vertices,
-			 bool use_indices
+			 std::size_t vertex_buffer_size,
+			 n_vertices number_vertices
 )
 	: _vertex_array_object(vertex_array_object),
 	  _vertex_buffer_object(vertex_buffer_object),
-	  _number_vertices(number_vertices),
-	  _use_indices(use_indices)
+	  _vertex_buffer_size(vertex_buffer_size),
+	  _number_vertices(number_vertices)
 {}
 
 void shape::free_buffers() {
 	glDeleteVertexArrays(1, &_vertex_array_object);
+	glDeleteBuffers(1, &_vertex_buffer_object);
+	buffer_stats::remove_buffer(_vertex_buffer_size);
 }
 
 shape shape::create(
-	const float* vertices,
+	const void* vertices,
 	n_vertices number_vertices,
 	const std::vector<attribute>& attributes
 ) {
 	unsigned int vao = create_vao();
-	unsigned int attributes_size = get_attributes_size(attributes);
+	std::size_t attributes_stride = get_attributes_stride(attributes);
 	unsigned int vbo;
-	vbo = buffer_vertices(vertices, number_vertices * attributes_size * sizeof(float));
+	const std::size_t vertex_buffer_size = number_vertices * attributes_stride;
+	vbo = buffer_vertices(vertices, vertex_buffer_size);
 	create_attribute_pointer(attributes);
 
-	return shape(vao, vbo, number_vertices, false);
+	return shape(vao, vbo, vertex_buffer_size, number_vertices);
 }
 
-void shape::bind() const {
-	glBindVertexArray(_vertex_array_object);
+void shape::free_quad_index_buffer() {
+	if (_quad_index_buffer != 0) {
+		glDeleteBuffers(1, &_quad_index_buffer);
+		buffer_stats::remove_buffer(_quad_index_buffer_quads * 6 * sizeof(std::uint32_t));
+		_quad_index_buffer = 0;
+		_quad_index_buffer_quads = 0;
+	}
 }
 
-bool shape::use_indices() const {
-	return _use_indices;
+void shape::bind() const {
+	glBindVertexArray(_vertex_array_object);
 }
 
 n_vertices shape::get_number_vertices() const {
@@ -60,37 +82,92 @@ unsigned int shape::create_vao() {
 	return vao;
 }
 
-unsigned int shape::buffer_vertices(const float* vertices, size_t vertices_size) {
+unsigned int shape::buffer_vertices(const void* vertices, size_t vertices_size) {
 	unsigned int vbo;
 	glGenBuffers(1, &vbo);
 	glBindBuffer(GL_ARRAY_BUFFER, vbo);
 	glBufferData(GL_ARRAY_BUFFER, vertices_size, vertices, GL_DYNAMIC_DRAW);
+	buffer_stats::add_buffer();
+	buffer_stats::resize_buffer(0, vertices_size);
 	return vbo;
 }
 
-n_floats shape::get_attributes_size(const std::vector<attribute>& attributes) {
-	unsigned int attributes_size = 0;
+void shape::bind_quad_indices(std::size_t number_quads) {
+	if (_quad_index_buffer == 0) {
+		glGenBuffers(1, &_quad_index_buffer);
+		buffer_stats::add_buffer();
+	}
+	// binding the buffer while the vao is bound stores it in the vao
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quad_index_buffer);
+
+	if (number_quads > _quad_index_buffer_quads) {
+		// the vaos, that use the buffer already, keep using it, as only its data is replaced
+		std::size_t new_quads = std::max(MIN_QUAD_INDEX_BUFFER_QUADS, _quad_index_buffer_quads);
+		while (new_quads < number_quads) {
+			new_quads *= 2;
+		}
+
+		std::vector<std::uint32_t> indices;
+		indices.reserve(6 * new_quads);
+		for (std::uint32_t quad = 0; quad < new_quads; quad++) {
+			for (std::uint32_t corner : {0, 1, 2, 2, 3, 0}) {
+				indices.push_back(4*quad + corner);
+			}
+		}
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(std::uint32_t), indices.data(), GL_STATIC_DRAW);
+		buffer_stats::resize_buffer(_quad_index_buffer_quads * 6 * sizeof(std::uint32_t), indices.size() * sizeof(std::uint32_t));
+		_quad_index_buffer_quads = new_quads;
+	}
+}
+
+std::size_t shape::get_type_size(unsigned int type) {
+	switch (type) {
+		case GL_BYTE:
+		case GL_UNSIGNED_BYTE:
+			return 1;
+		case GL_SHORT:
+		case GL_UNSIGNED_SHORT:
+			return 2;
+		default:
+			return 4;
+	}
+}
+
+std::size_t shape::get_attributes_stride(const std::vector<attribute>& attributes) {
+	std::size_t attributes_stride = 0;
 	for (const attribute& a : attributes)
 	{
-		attributes_size += a.size;
+		attributes_stride += a.size * get_type_size(a.type);
 	}
-	return attributes_size;
+	return attributes_stride;
 }
 
-void shape::create_attribute_pointer(const std::vector<attribute>& attributes) {
-	size_t attributes_stride = get_attributes_size(attributes) * sizeof(float);
+void shape::create_attribute_pointer(const std::vector<attribute>& attributes, unsigned int first_location, unsigned int divisor) {
+	size_t attributes_stride = get_attributes_stride(attributes);
 
 	size_t offset = 0;
 	for (unsigned int i = 0; i < attributes.size(); i++) {
-		glVertexAttribPointer(
-			i,
-			attributes[i].size,
-			attributes[i].type,
-			GL_FALSE,
-			attributes_stride,
-			(void*)offset
-		);
-		offset += attributes[i].size * sizeof(float);
-		glEnableVertexAttribArray(i);
+		const unsigned int location = first_location + i;
+		if (attributes[i].integer) {
+			glVertexAttribIPointer(
+				location,
+				attributes[i].size,
+				attributes[i].type,
+				attributes_stride,
+				(void*)offset
+			);
+		} else {
+			glVertexAttribPointer(
+				location,
+				attributes[i].size,
+				attributes[i].type,
+				attributes[i].normalized ? GL_TRUE : GL_FALSE,
+				attributes_stride,
+				(void*)offset
+			);
+		}
+		offset += attributes[i].size * get_type_size(attributes[i].type);
+		glEnableVertexAttribArray(location);
+		glVertexAttribDivisor(location, divisor);
 	}
 }
@@ -20,27 +20,36 @@ using n_floats = std::size_t;
 using n_triangles = std::size_t;
 
 /**
- * An attribute defining the size in number of floats and the type of vertices.
+ * An attribute defining the number of components and the type of vertices.
  */
 struct attribute {
-	attribute(n_floats s, unsigned int t)
-		: size(s), type(t)
+	attribute(std::size_t s, unsigned int t, bool n = false, bool i = false)
+		: size(s), type(t), normalized(n), integer(i)
 	{}
 	/**
-	 * The number of floats this attribute takes.
+	 * The number of components this attribute takes.
 	 */
-	n_floats size;
+	std::size_t size;
 
 	/**
-	 * The type of this attribute
+	 * The type of the components of this attribute
 	 */
 	unsigned int type;
+
+	/**
+	 * If true, integer components are mapped to [0, 1] or [-1, 1] in the shader.
+	 */
+	bool normalized;
+
+	/**
+	 * If true, the components stay integers in the shader. Otherwise they are converted to floats.
+	 */
+	bool integer;
 };
 
 /**
  * A shape defines the following attributes:
  *   - Vertices
- *   - Indices if any
  *   - Attributepointers
  */
 class shape {
@@ -48,7 +57,8 @@ class shape {
 		shape() {}
 
 		/**
-		 * Deletes all used buffers of this shape.
+		 * Deletes the vao and the vertex buffer of this shape.
+		 * The shared quad index buffer is freed with free_quad_index_buffer.
 		 * After calling this function this shape cant be used for rendering.
 		 */
 		void free_buffers();
@@ -61,22 +71,48 @@ class shape {
 		 * @param vertices_size The number of the vertices.
 		 * 						If you have 2 triangles this would be 2*3=6
 		 * @param attributes A list of attributes, which define the order of the vertices.
+		 * 					 The attributes of a vertex are tightly packed.
 		 */
 		static shape create(
-			const float* vertices,
+			const void* vertices,
 			n_vertices number_vertices,
 			const std::vector<attribute>& attributes
 		);
 
+		/**
+		 * Deletes the shared quad index buffer.
+		 * After calling this function no vao, that uses it, can be used for rendering.
+		 */
+		static void free_quad_index_buffer();
+
+		/**
+		 * Binds the shared quad index buffer to the bound vao. It splits every quad into two triangles
+		 * (corners 0, 1, 2 and 2, 3, 0), so quads with four corners in order around the quad can be drawn with glDrawElements.
+		 * Grows the buffer first, if it holds less than number_quads quads. It has to be freed with free_quad_index_buffer.
+		 */
+		static void bind_quad_indices(std::size_t number_quads);
+
+		/**
+		 * Sets up the given attributes of the vertex buffer bound to GL_ARRAY_BUFFER for the bound vao.
+		 *
+		 * @param first_location The location of the first attribute, the others follow
+		 * @param divisor 0 to advance the attributes per vertex, 1 to advance them per instance
+		 */
+		static void create_attribute_pointer(const std::vector<attribute>& attributes, unsigned int first_location = 0, unsigned int divisor = 0);
+
+		/**
+		 * @return The sum of the number of bytes used by all attributes.
+		 */
+		static std::size_t get_attributes_stride(const std::vector<attribute>& attributes);
+
 		/**
 		 * Binds this shape to use for rendering.
-		 * After this call the Vertices, Indices and AttributePointer of this
-		 * shape are used by any call of glDrawArrays or glDrawElements.
+		 * After this call the Vertices and AttributePointer of this
+		 * shape are used by any call of glDrawArrays.
 		 */
 		void bind() const;
 
 		// Getter
-		bool use_indices() const;
 		n_vertices get_number_vertices() const;
 
 		/**
@@ -87,11 +123,14 @@ class shape {
 		/*
 		 * Attributes, which can be useful.
 		 */
+		static const attribute scalar_attribute;
 		static const attribute position_attribute;
 		static const attribute position2_attribute;
 		static const attribute color_attribute;
 		static const attribute texture_coordinate_attribute;
 		static const attribute normale_attribute;
+		static const attribute packed_attribute;
+		static const attribute normalized_color_attribute;
 
 	private:
 		/**
@@ -99,14 +138,14 @@ class shape {
 		 *
 		 * @param vertex_array_object The id of the vao of this shape
 		 * @param vertex_buffer_object The id of the vbo of this shape
+		 * @param vertex_buffer_size The size of the vbo in bytes
 		 * @param number_vertices The number of vertices used by this shape
-		 * @param use_indices If true use glDrawElements otherwise glDrawArrays.
 		 */
 		shape(
 			unsigned int vertex_array_object,
 			unsigned int vertex_buffer_object,
-			n_vertices number_vertices,
-			bool use_indices
+			std::size_t vertex_buffer_size,
+			n_vertices number_vertices
 		);
 
 		/**
@@ -119,22 +158,25 @@ class shape {
 		/**
 		 * Buffers the given vertices and returns the id of the created vbo.
 		 *
-		 * @param vertices The vertices as float array
+		 * @param vertices The vertices
 		 * @param vertices_size The size number of all vertices added together in bytes
 		 * @return The id of the new vbo
 		 */
-		static unsigned int buffer_vertices(const float* vertices, size_t vertices_size);
+		static unsigned int buffer_vertices(const void* vertices, size_t vertices_size);
 
 		/**
-		 * @return The sum of the number of floats used by all attributes.
+		 * @return The size of one component of the given type in bytes.
 		 */
-		static n_floats get_attributes_size(const std::vector<attribute>& attributes);
-		static void create_attribute_pointer(const std::vector<attribute>& attributes);
+		static std::size_t get_type_size(unsigned int type);
+
 
 		unsigned int _vertex_array_object;
 		unsigned int _vertex_buffer_object;
+		std::size_t _vertex_buffer_size;
 		n_vertices _number_vertices;
-		bool _use_indices;
+
+		static unsigned int _quad_index_buffer;
+		static std::size_t _quad_index_buffer_quads;
 };
 
 #endif
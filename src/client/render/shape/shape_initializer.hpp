@@ -98,22 +98,6 @@ namespace initialize {
 		-VISOR_SMALL_SIZE, -VISOR_BIG_SIZE
 	};
 
-	struct triangle_coordinate_index {
-		triangle_coordinate_index(std::uint8_t c, std::int8_t d) : coord(c), direction(d) {}
-
-		std::uint8_t coord;
-		std::int8_t direction;
-	};
-
-	const static triangle_coordinate_index triangle_coordinate_indices[] {
-		triangle_coordinate_index(2, -1), // min z
-		triangle_coordinate_index(2,  1), // max z
-		triangle_coordinate_index(0, -1), // min x
-		triangle_coordinate_index(0,  1), // max x
-		triangle_coordinate_index(1, -1), // min y
-		triangle_coordinate_index(1,  1), // max y
-	};
-
 	/**
 	 * Returns a Shape defining a cube.
 	 */
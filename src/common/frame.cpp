@@ -7,32 +7,62 @@
 constexpr unsigned int WIN_LIMIT = 2;
 constexpr float BUILD_RANGE = 5.f;
 constexpr float DESTROY_RANGE = 5.f;
+// sheep closer than this to a changed block wake up
+constexpr float SHEEP_WAKE_UP_RANGE = 2.f;
+// players push sheep away, that are closer than this
+constexpr float PLAYER_PUSH_RANGE = 0.8f;
 
-frame::frame() {}
+// the streams of the sheep generators start after the stream of the frame
+constexpr std::uint64_t FRAME_RANDOM_STREAM = 0;
+constexpr std::uint64_t SHEEP_RANDOM_STREAM_OFFSET = 1;
 
-player* frame::get_player(char player_id) {
-	player* a_player = nullptr;
-	for (player& p : players) {
-		if (p.get_id() == player_id) {
-			a_player = &p;
-			break;
-		}
+frame::frame() : _blue_win_counter(0), _pool(nullptr) {}
+
+void frame::init(unsigned int match_seed, unsigned int num_sheep) {
+	_random = random_generator(match_seed, FRAME_RANDOM_STREAM);
+	blocks = block_container(block_container::create_field(match_seed));
+
+	sheeps.clear();
+	for (unsigned int i = 0; i < num_sheep; i++) {
+		random_generator sheep_random(match_seed, SHEEP_RANDOM_STREAM_OFFSET + i);
+		const glm::vec3 position = blocks.get_sheep_respawn_position(&sheep_random);
+		sheeps.add(position, 0.f, sheep_random);
 	}
-	return a_player;
 }
 
-bool frame::tick() {
+void frame::add_player(char player_id, const std::string& name) {
+	players.insert(player(player_id, name, blocks.get_respawn_position(&_random)));
+}
+
+void frame::set_thread_pool(thread_pool* pool) {
+	_pool = pool;
+}
+
+player* frame::get_player(char player_id) {
+	return players.get(player_id);
+}
+
+bool frame::tick(float delta_time) {
+	// Players write to the sheep they hooked, so they are ticked serially in a fixed order.
+	// This is where all cross entity effects are merged, before any sheep is ticked.
 	for (player& p : players) {
-		if (p.tick(blocks, sheeps)) {
+		// players are ticked in order, so they share the generator of the frame
+		if (p.tick(blocks, sheeps, &_random, delta_time)) {
 			_blue_win_counter++;
 		}
+		sheeps.push_away(p.get_position(), PLAYER_PUSH_RANGE, delta_time);
 		check_destroy_block(&p);
 		check_add_block(&p);
 	}
 
-	for (sheep& s : sheeps) {
-		s.tick(blocks);
+	std::vector<glm::vec3> player_positions;
+	for (const player& p : players) {
+		player_positions.push_back(p.get_position());
 	}
+	sheeps.set_player_positions(player_positions);
+
+	// a sheep only reads the world and writes itself, so all sheep can be ticked in parallel
+	sheeps.tick(blocks, _pool, delta_time);
 
 	return _blue_win_counter >= WIN_LIMIT;
 }
@@ -43,6 +73,7 @@ void frame::check_destroy_block(player* p) {
 		if (block_to_destroy && world_block::destroyable(block_to_destroy->get_type())) {
 			blocks.remove_block(block_to_destroy->get_position());
 			block_removes.push_back(block_to_destroy->get_position());
+			sheeps.wake_up_near(glm::vec3(block_to_destroy->get_position()), SHEEP_WAKE_UP_RANGE);
 		}
 	}
 }
@@ -53,6 +84,7 @@ void frame::check_add_block(player* p) {
 		if (block_placement_position) {
 			blocks.add_block(*block_placement_position, block_type::NORMAL);
 			block_additions.push_back(*block_placement_position);
+			sheeps.wake_up_near(glm::vec3(*block_placement_position), SHEEP_WAKE_UP_RANGE);
 		}
 	}
 }
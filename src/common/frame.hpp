@@ -3,26 +3,47 @@
 
 #include <vector>
 
-#include "player.hpp"
-#include "sheep.hpp"
+#include "player_map.hpp"
+#include "sheep_store.hpp"
 #include "world/block_container.hpp"
+#include "random_generator.hpp"
+
+class thread_pool;
 
 class frame {
 	public:
 		frame();
+
+		/**
+		 * Creates the map and the sheep of a match.
+		 * Every random decision of the simulation derives from the match seed.
+		 */
+		void init(unsigned int match_seed, unsigned int num_sheep);
+		void add_player(char player_id, const std::string& name);
+
+		/**
+		 * Sheep are ticked in parallel on the given pool. Without a pool they are ticked serially.
+		 */
+		void set_thread_pool(thread_pool* pool);
 		player* get_player(char player_id);
 
-		bool tick();
+		/**
+		 * Advances the match by delta_time seconds. Returns true, if the match is won.
+		 */
+		bool tick(float delta_time);
 		void check_destroy_block(player* p);
 		void check_add_block(player* p);
 
-		std::vector<player> players;
-		std::vector<sheep> sheeps;
+		player_map players;
+		sheep_store sheeps;
 		block_container blocks;
+		// collected over all ticks until the next game update is published
 		std::vector<glm::ivec3> block_removes;
 		std::vector<glm::ivec3> block_additions;
 	private:
 		unsigned int _blue_win_counter;
+		random_generator _random;
+		thread_pool* _pool;
 };
 
 #endif
@@ -5,7 +5,7 @@
 #include <glm/gtx/norm.hpp>
 
 #include "world/block_container.hpp"
-#include "sheep.hpp"
+#include "sheep_store.hpp"
 #include "physics/forms.hpp"
 
 hook::hook() {}
@@ -22,7 +22,7 @@ bool hook::is_hooked() const {
 	return target_point.has_value() || target_sheep_index.has_value();
 }
 
-void hook::check_target(const block_container& blocks, std::vector<sheep>& sheeps, float hook_range) {
+void hook::check_target(const block_container& blocks, sheep_store& sheeps, float hook_range) {
 	if (!is_hooked()) {
 		std::optional<glm::vec3> cp = blocks.get_collision_point(ray(position, direction), range);
 		if (cp) {
@@ -31,22 +31,13 @@ void hook::check_target(const block_container& blocks, std::vector<sheep>& sheep
 			}
 		}
 
-		glm::vec3 sheep_position;
-		int sheep_index(-1);
-		for (unsigned int i = 0; i < sheeps.size(); i++) {
-			if (sheeps[i].is_colliding(ray(position, direction), range)) {
-				if ((sheep_index != -1) && glm::distance2(position, sheeps[i].get_position()) > glm::distance2(position, sheep_position)) continue;
-				if (glm::distance2(sheeps[i].get_position(), position) > hook_range*hook_range) continue;
-				sheep_position = sheeps[i].get_position();
-				sheep_index = i;
-			}
-		}
-
-		if (sheep_index != -1) {
-			if (glm::distance2(*cp, position) > glm::distance2(sheep_position, position)) {
+		std::optional<std::size_t> sheep_index = sheeps.get_colliding_sheep(ray(position, direction), range, hook_range);
+		if (sheep_index) {
+			const glm::vec3 sheep_position = sheeps[*sheep_index].get_position();
+			if (!cp || glm::distance2(*cp, position) > glm::distance2(sheep_position, position)) {
 				target_point.reset();
-				target_sheep_index = sheep_index;
-				sheeps[sheep_index].set_is_hooked(true);
+				target_sheep_index = *sheep_index;
+				sheeps[*sheep_index].set_is_hooked(true);
 			}
 		}
 	}
@@ -7,11 +7,12 @@
 #include "world/world_block.hpp"
 
 class block_container;
-class sheep;
+class sheep_store;
 
 constexpr float HOOK_RANGE = 15.f;
-constexpr float HOOK_SPEED = 250.f;
-constexpr float HOOK_ACCELERATION = 0.35f; 
+// per second
+constexpr float HOOK_SPEED = 6250.f;
+constexpr float HOOK_ACCELERATION = 218.75f;
 
 class hook {
 	public:
@@ -20,7 +21,7 @@ class hook {
 		hook(const std::optional<glm::vec3>& target_point);
 
 		bool is_hooked() const;
-		void check_target(const block_container& blocks, std::vector<sheep>& sheeps, float hook_range);
+		void check_target(const block_container& blocks, sheep_store& sheeps, float hook_range);
 
 		glm::vec3 position;
 		glm::vec3 direction;
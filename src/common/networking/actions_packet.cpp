@@ -5,26 +5,107 @@
 #include "packet_ids.hpp"
 #include "packet_helper.hpp"
 
-actions_packet::actions_packet() {}
+// every frame starts with a flag byte, that defines which deltas follow
+constexpr std::uint8_t ACTIONS_CHANGED_FLAG = 1 << 0;
+constexpr std::uint8_t MOUSE_CHANGED_FLAG   = 1 << 1;
 
-actions_packet::actions_packet(std::uint16_t actions, const glm::vec2& mouse_changes) : actions(actions), mouse_changes(mouse_changes) {}
+// reads one field, if the rest of the buffer is long enough for it
+template<typename T>
+bool read_checked(T* obj, const char** buffer_ptr, const char* buffer_end) {
+	if (static_cast<std::size_t>(buffer_end - *buffer_ptr) < sizeof(T)) {
+		return false;
+	}
+	packet_helper::read_from_buffer(obj, buffer_ptr);
+	return true;
+}
+
+actions_packet::input_frame::input_frame() : actions(0) {}
+
+actions_packet::input_frame::input_frame(std::uint16_t actions, const glm::vec2& mouse_changes) : actions(actions), mouse_changes(mouse_changes) {}
+
+actions_packet::actions_packet() : sequence(0) {}
 
-actions_packet actions_packet::from_message(const std::vector<char>& buffer) {
-	if (buffer[0] != packet_ids::ACTIONS_PACKET) {
+actions_packet::actions_packet(std::uint32_t sequence, const std::vector<input_frame>& frames) : sequence(sequence), frames(frames) {}
+
+std::optional<actions_packet> actions_packet::from_message(const std::vector<char>& buffer) {
+	if (buffer.empty() || buffer[0] != packet_ids::ACTIONS_PACKET) {
 		std::cerr << "invalid actions packet" << std::endl;
+		return {};
 	}
 
 	actions_packet packet;
 
 	const char* buffer_ptr = &buffer[1];
+	const char* buffer_end = buffer.data() + buffer.size();
+
+	std::uint8_t num_frames(0);
+	if (!read_checked(&packet.sequence, &buffer_ptr, buffer_end) || !read_checked(&num_frames, &buffer_ptr, buffer_end)) {
+		std::cerr << "truncated actions packet" << std::endl;
+		return {};
+	}
+	if (num_frames > NUM_REDUNDANT_INPUT_FRAMES) {
+		std::cerr << "actions packet with " << (int)num_frames << " frames" << std::endl;
+		return {};
+	}
 
-	packet_helper::read_from_buffer(&packet.actions, &buffer_ptr);
-	packet_helper::read_from_buffer(&packet.mouse_changes, &buffer_ptr);
+	std::uint16_t last_actions = 0;
+	for (std::uint8_t i = 0; i < num_frames; i++) {
+		std::uint8_t flags(0);
+		if (!read_checked(&flags, &buffer_ptr, buffer_end)) {
+			std::cerr << "truncated actions packet" << std::endl;
+			return {};
+		}
+
+		input_frame frame(last_actions, glm::vec2());
+		if (flags & ACTIONS_CHANGED_FLAG) {
+			std::uint16_t actions_delta(0);
+			if (!read_checked(&actions_delta, &buffer_ptr, buffer_end)) {
+				std::cerr << "truncated actions packet" << std::endl;
+				return {};
+			}
+			frame.actions ^= actions_delta;
+		}
+		if (flags & MOUSE_CHANGED_FLAG) {
+			if (!read_checked(&frame.mouse_changes, &buffer_ptr, buffer_end)) {
+				std::cerr << "truncated actions packet" << std::endl;
+				return {};
+			}
+		}
+
+		packet.frames.push_back(frame);
+		last_actions = frame.actions;
+	}
 	return packet;
 }
 
-void actions_packet::write_to(std::vector<char>* buffer) {
+void actions_packet::write_to(std::vector<char>* buffer) const {
 	buffer->push_back(packet_ids::ACTIONS_PACKET);
-	packet_helper::write_to_buffer(actions, buffer);
-	packet_helper::write_to_buffer(mouse_changes, buffer);
+	packet_helper::write_to_buffer(sequence, buffer);
+	packet_helper::write_to_buffer(static_cast<std::uint8_t>(frames.size()), buffer);
+
+	// actions are written as xor to the previous frame, mouse changes only if there are some
+	std::uint16_t last_actions = 0;
+	for (const input_frame& frame : frames) {
+		const std::uint16_t actions_delta = frame.actions ^ last_actions;
+		std::uint8_t flags = 0;
+		if (actions_delta) {
+			flags |= ACTIONS_CHANGED_FLAG;
+		}
+		if (frame.mouse_changes != glm::vec2()) {
+			flags |= MOUSE_CHANGED_FLAG;
+		}
+
+		packet_helper::write_to_buffer(flags, buffer);
+		if (flags & ACTIONS_CHANGED_FLAG) {
+			packet_helper::write_to_buffer(actions_delta, buffer);
+		}
+		if (flags & MOUSE_CHANGED_FLAG) {
+			packet_helper::write_to_buffer(frame.mouse_changes, buffer);
+		}
+		last_actions = frame.actions;
+	}
+}
+
+std::uint32_t actions_packet::get_frame_sequence(std::size_t index) const {
+	return sequence - static_cast<std::uint32_t>(frames.size() - 1 - index);
 }
@@ -2,6 +2,7 @@
 #define __ACTIONS_PACKET_CLASS__
 
 #include <cstdint>
+#include <optional>
 #include <vector>
 
 #include <glm/glm.hpp>
@@ -16,16 +17,44 @@ constexpr std::uint16_t LEFT_MOUSE_PRESSED =  1 << 6;
 constexpr std::uint16_t RIGHT_MOUSE_PRESSED = 1 << 7;
 constexpr std::uint16_t HOOK_ACTION =         1 << 8;
 
+// number of input frames every actions packet repeats
+constexpr std::size_t NUM_REDUNDANT_INPUT_FRAMES = 8;
+
+/**
+ * Carries the last input frames of a client.
+ * Every frame is sent multiple times, so a lost datagram does not lose input.
+ * The receiver only applies frames with a sequence number it has not seen yet.
+ */
 class actions_packet {
 	public:
+		struct input_frame {
+			input_frame();
+			input_frame(std::uint16_t actions, const glm::vec2& mouse_changes);
+
+			std::uint16_t actions;
+			glm::vec2 mouse_changes;
+		};
+
 		actions_packet();
-		actions_packet(std::uint16_t actions, const glm::vec2& mouse_changes);
-		static actions_packet from_message(const std::vector<char>& buffer);
+		actions_packet(std::uint32_t sequence, const std::vector<input_frame>& frames);
+		/**
+		 * Returns nothing for truncated packets and packets with more than NUM_REDUNDANT_INPUT_FRAMES frames,
+		 * as the message comes from the network unchecked.
+		 */
+		static std::optional<actions_packet> from_message(const std::vector<char>& buffer);
+
+		void write_to(std::vector<char>* buffer) const;
+
+		/**
+		 * Returns the sequence number of the frame with the given index.
+		 */
+		std::uint32_t get_frame_sequence(std::size_t index) const;
 
-		void write_to(std::vector<char>* buffer);
+		// sequence number of the newest frame
+		std::uint32_t sequence;
 
-		std::uint16_t actions;
-		glm::vec2 mouse_changes;
+		// the oldest frame comes first
+		std::vector<input_frame> frames;
 };
 
 #endif
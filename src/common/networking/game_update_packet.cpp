@@ -2,8 +2,8 @@
 
 #include <iostream>
 
-#include "../player.hpp"
-#include "../sheep.hpp"
+#include "../player_map.hpp"
+#include "../sheep_store.hpp"
 #include "packet_helper.hpp"
 #include "packet_ids.hpp"
 
@@ -40,7 +40,7 @@ namespace packet_helper {
 // player info
 game_update_packet::player_info::player_info() {}
 
-game_update_packet::player_info::player_info(const player& p, const std::vector<sheep>& sheeps)
+game_update_packet::player_info::player_info(const player& p, const sheep_store& sheeps)
 	: id(p.get_id()), position(p.get_position()), view_angles(p.get_view_angles())
 {
 	if (p.get_hook()) {
@@ -57,16 +57,16 @@ game_update_packet::sheep_info::sheep_info() {}
 game_update_packet::sheep_info::sheep_info(const sheep& s) : position(s.get_position()), yaw(s.get_yaw()) {}
 
 
-sheep game_update_packet::sheep_info::create_sheep() const {
-	return sheep(position, yaw);
+sheep game_update_packet::sheep_info::create_sheep(sheep_store* sheeps) const {
+	return sheeps->add(position, yaw);
 }
 
 // game update packet
 game_update_packet::game_update_packet() {}
 
 game_update_packet game_update_packet::from_game(
-	const std::vector<player>& players,
-	const std::vector<sheep>& sheeps,
+	const player_map& players,
+	const sheep_store& sheeps,
 	const std::vector<glm::ivec3>& block_removes,
 	const std::vector<glm::ivec3>& block_additions
 ) {
@@ -9,13 +9,15 @@
 #include "../hook.hpp"
 
 class player;
+class player_map;
 class sheep;
+class sheep_store;
 
 class game_update_packet {
 	public:
 		struct player_info {
 			player_info();
-			player_info(const player& p, const std::vector<sheep>& sheeps);
+			player_info(const player& p, const sheep_store& sheeps);
 
 			char id;
 			glm::vec3 position;
@@ -28,14 +30,14 @@ class game_update_packet {
 			sheep_info();
 			sheep_info(const sheep& s);
 
-			sheep create_sheep() const;
+			sheep create_sheep(sheep_store* sheeps) const;
 
 			glm::vec3 position;
 			float yaw;
 		};
 
 		game_update_packet();
-		static game_update_packet from_game(const std::vector<player>& players, const std::vector<sheep>& sheeps, const std::vector<glm::ivec3>& block_removes, const std::vector<glm::ivec3>& block_additions);
+		static game_update_packet from_game(const player_map& players, const sheep_store& sheeps, const std::vector<glm::ivec3>& block_removes, const std::vector<glm::ivec3>& block_additions);
 		static game_update_packet from_message(const std::vector<char>& message);
 
 		void write_to(std::vector<char>* buffer) const;
@@ -1,28 +1,39 @@
 #include "body.hpp"
 
+#include "util.hpp"
 #include "../world/block_container.hpp"
 
-body::body() {}
+constexpr float BLOCK_HALF_SIZE = 0.5f;
+// bodies moving further than this per tick land before they slide
+constexpr float FAST_FALL_DISTANCE = 0.2f;
+// bodies rest this far inside the ground, so the bottom collider touches it
+constexpr float COLLISION_SKIN = 0.01f;
+// blocks, that a body overlaps by less than this, still stop it
+constexpr float CONTACT_TOLERANCE = 0.001f;
+
+body::body() : _basis_valid(false) {}
 
 body::body(const glm::vec3& position, const glm::vec3& size, const glm::vec3 speed, const glm::vec2& view_angles, const float collider_dimension)
-	: position(position), size(size), speed(speed), view_angles(view_angles), collider_dimension(collider_dimension)
+	: position(position), size(size), speed(speed), collider_dimension(collider_dimension), _view_angles(view_angles), _basis_valid(false)
 {}
 
-void body::physics(const block_container& blocks) {
-	bool y_checked = false;
-	if (glm::abs(speed.y) > 0.2f) {
-		check_collider(blocks, get_bottom_collider(), -1, 1);
-		check_collider(blocks, get_top_collider()   ,  1, 1);
-		y_checked = true;
-	}
-	check_collider(blocks, get_left_collider()  , -1, 2);
-	check_collider(blocks, get_right_collider() ,  1, 2);
-	check_collider(blocks, get_back_collider()  , -1, 0);
-	check_collider(blocks, get_front_collider() ,  1, 0);
-
-	if (!y_checked) {
-		check_collider(blocks, get_bottom_collider(), -1, 1);
-		check_collider(blocks, get_top_collider()   ,  1, 1);
+// Moves the body by its speed over delta_time and stops it at the first blocks in its way.
+// The axes are swept one after the other, so a body can slide along walls and the ground.
+void body::physics(const block_container& blocks, float delta_time) {
+	const glm::vec3 displacement = speed * delta_time;
+
+	// one query for all blocks the body could touch on its way
+	const float reach = glm::max(size.y - COLLISION_SKIN, collider_dimension);
+	const glm::vec3 target = position + displacement;
+	const cuboid swept_volume((position + target) * 0.5f, glm::abs(displacement) * 0.5f + glm::vec3(reach));
+	const std::vector<world_block> candidates = blocks.get_colliding_blocks(swept_volume);
+
+	// fast falling bodies land before they slide
+	const unsigned int falling_order[] = {1, 2, 0};
+	const unsigned int walking_order[] = {2, 0, 1};
+	const unsigned int* order = glm::abs(displacement.y) > FAST_FALL_DISTANCE ? falling_order : walking_order;
+	for (unsigned int i = 0; i < 3; i++) {
+		sweep_axis(candidates, displacement[order[i]], order[i]);
 	}
 }
 
@@ -37,18 +48,35 @@ void body::apply_drag(glm::vec3& tmp_speed, float drag, float max_speed) {
 	}
 }
 
-// direction = -1, if block is in negative direction to player
-void body::check_collider(const block_container& blocks, const cuboid& collider, int direction, unsigned int coordinate) {
-	std::vector<world_block> colliding_blocks = blocks.get_colliding_blocks(collider);
-	if (!colliding_blocks.empty()) {
-		if (speed[coordinate]*direction > 0.f) {
-			speed[coordinate] = 0.f;
+// Along the swept axis the body reaches size.y - COLLISION_SKIN, on the other axes collider_dimension.
+void body::sweep_axis(const std::vector<world_block>& candidates, float displacement, unsigned int axis) {
+	const float direction = displacement < 0.f ? -1.f : 1.f;
+	const float front = position[axis] + (size.y - COLLISION_SKIN)*direction;
+	float travel = glm::abs(displacement);
+	bool hit = false;
+
+	for (const world_block& wb : candidates) {
+		const glm::vec3 block_position(wb.get_position());
+
+		bool in_path = true;
+		for (unsigned int other = 0; other < 3; other++) {
+			if (other != axis && glm::abs(block_position[other] - position[other]) >= collider_dimension + BLOCK_HALF_SIZE) {
+				in_path = false;
+			}
 		}
-		float min_coord = colliding_blocks[0].get_position()[coordinate]*direction;
-		for (const world_block& wb : colliding_blocks) {
-			min_coord = glm::min(min_coord, static_cast<float>(wb.get_position()[coordinate]*direction));
+		if (!in_path) continue;
+
+		// distance between the front of the body and the near side of the block
+		const float distance = (block_position[axis] - BLOCK_HALF_SIZE*direction - front) * direction;
+		if (distance > -CONTACT_TOLERANCE && distance < travel) {
+			travel = glm::max(distance, 0.f);
+			hit = true;
 		}
-		position[coordinate] = (min_coord*direction) - (0.5f + size.y - 0.01f)*direction;
+	}
+
+	position[axis] += travel*direction;
+	if (hit) {
+		speed[axis] = 0.f;
 	}
 }
 
@@ -56,60 +84,46 @@ glm::vec3 body::get_up() {
 	return glm::vec3(0.0f, 1.0f, 0.0f);
 }
 
-glm::vec3 body::get_right() const {
-	return glm::normalize(glm::cross(get_direction(), body::get_up()));
-}
-
-glm::vec3 body::get_direction() const {
-	return glm::normalize(glm::vec3(
-				cos(glm::radians(view_angles.x)) * cos(glm::radians(view_angles.y)),
-				sin(glm::radians(view_angles.x)),
-				cos(glm::radians(view_angles.x)) * sin(glm::radians(view_angles.y))
-			));
+const glm::vec2& body::get_view_angles() const {
+	return _view_angles;
 }
 
-glm::vec3 body::get_top() const {
-	return glm::normalize(glm::cross(get_right(), get_direction()));
-}
-
-cuboid body::get_bottom_collider() const {
-	return cuboid(
-		glm::vec3(position.x, position.y-0.4f, position.z),
-		glm::vec3(collider_dimension, 0.1f, collider_dimension)
-	);
+void body::set_view_angles(const glm::vec2& view_angles) {
+	_view_angles = view_angles;
+	_basis_valid = false;
 }
 
-cuboid body::get_top_collider() const {
-	return cuboid(
-		glm::vec3(position.x, position.y+0.4f, position.z),
-		glm::vec3(collider_dimension, 0.1f, collider_dimension)
-	);
+const glm::vec3& body::get_right() const {
+	if (!_basis_valid) update_basis();
+	return _right;
 }
 
-cuboid body::get_left_collider() const {
-	return cuboid(
-		glm::vec3(position.x, position.y, position.z-0.4f),
-		glm::vec3(collider_dimension, collider_dimension, 0.1f)
-	);
+const glm::vec3& body::get_direction() const {
+	if (!_basis_valid) update_basis();
+	return _direction;
 }
 
-cuboid body::get_right_collider() const {
-	return cuboid(
-		glm::vec3(position.x, position.y, position.z+0.4f),
-		glm::vec3(collider_dimension, collider_dimension, 0.1f)
-	);
+const glm::vec3& body::get_top() const {
+	if (!_basis_valid) update_basis();
+	return _top;
 }
 
-cuboid body::get_front_collider() const {
-	return cuboid(
-		glm::vec3(position.x+0.4f, position.y, position.z),
-		glm::vec3(0.1f, collider_dimension, collider_dimension)
-	);
+// The closed forms of the normalized direction, right = direction x up and top = right x direction.
+// They are unit vectors, as long as the pitch stays within (-90, 90).
+void body::update_basis() const {
+	float sin_pitch, cos_pitch, sin_yaw, cos_yaw;
+	sin_cos(glm::radians(_view_angles.x), &sin_pitch, &cos_pitch);
+	sin_cos(glm::radians(_view_angles.y), &sin_yaw, &cos_yaw);
+
+	_direction = glm::vec3(cos_pitch*cos_yaw, sin_pitch, cos_pitch*sin_yaw);
+	_right = glm::vec3(-sin_yaw, 0.f, cos_yaw);
+	_top = glm::vec3(-sin_pitch*cos_yaw, cos_pitch, -sin_pitch*sin_yaw);
+	_basis_valid = true;
 }
 
-cuboid body::get_back_collider() const {
+cuboid body::get_bottom_collider() const {
 	return cuboid(
-		glm::vec3(position.x-0.4f, position.y, position.z),
-		glm::vec3(0.1f, collider_dimension, collider_dimension)
+		glm::vec3(position.x, position.y-0.4f, position.z),
+		glm::vec3(collider_dimension, 0.1f, collider_dimension)
 	);
 }
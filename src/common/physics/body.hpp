@@ -1,39 +1,56 @@
 #ifndef __BODY_CLASS__
 #define __BODY_CLASS__
 
+#include <vector>
+
 #include <glm/vec3.hpp>
 #include <glm/vec2.hpp>
 
 #include "forms.hpp"
 
 class block_container;
+class world_block;
 
 class body {
 	public:
 		body();
 		body(const glm::vec3& position, const glm::vec3& size, const glm::vec3 speed, const glm::vec2& view_angles, const float collider_dimension);
 
-		void physics(const block_container& blocks);
+		/**
+		 * Moves the body by its speed over delta_time seconds.
+		 * The body is swept through the world, so it can not tunnel through blocks.
+		 */
+		void physics(const block_container& blocks, float delta_time);
 		static void apply_drag(glm::vec3& tmp_speed, float drag, float max_speed);
-		void check_collider(const block_container& blocks, const cuboid& collider, int direction, unsigned int coordinate);
 
+		const glm::vec2& get_view_angles() const;
+		void set_view_angles(const glm::vec2& view_angles);
+
+		/**
+		 * The direction basis is computed from the view angles on first use and cached,
+		 * until the view angles change.
+		 */
 		static glm::vec3 get_up();
-		glm::vec3 get_right() const;
-		glm::vec3 get_direction() const;
-		glm::vec3 get_top() const;
+		const glm::vec3& get_right() const;
+		const glm::vec3& get_direction() const;
+		const glm::vec3& get_top() const;
 
 		cuboid get_bottom_collider() const;
-		cuboid get_top_collider() const;
-		cuboid get_left_collider() const;
-		cuboid get_right_collider() const;
-		cuboid get_front_collider() const;
-		cuboid get_back_collider() const;
 
 		glm::vec3 position;
 		glm::vec3 size;
 		glm::vec3 speed;
-		glm::vec2 view_angles;
 		float collider_dimension;
+	private:
+		void sweep_axis(const std::vector<world_block>& candidates, float displacement, unsigned int axis);
+		void update_basis() const;
+
+		glm::vec2 _view_angles;
+
+		mutable bool _basis_valid;
+		mutable glm::vec3 _direction;
+		mutable glm::vec3 _right;
+		mutable glm::vec3 _top;
 };
 
 #endif
@@ -0,0 +1,113 @@
+#include "entity_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+entity_grid::entity_grid(float cell_size, unsigned int x_size, unsigned int z_size)
+	: _cell_size(cell_size),
+	  _num_cells_x(static_cast<int>(std::ceil(x_size / cell_size))),
+	  _num_cells_z(static_cast<int>(std::ceil(z_size / cell_size))),
+	  _heads(_num_cells_x*_num_cells_z, -1)
+{}
+
+void entity_grid::clear() {
+	std::fill(_heads.begin(), _heads.end(), -1);
+	_next.clear();
+	_previous.clear();
+	_cells.clear();
+}
+
+void entity_grid::insert(std::uint32_t entity, const glm::vec3& position) {
+	_next.push_back(-1);
+	_previous.push_back(-1);
+	_cells.push_back(-1);
+	link(entity, get_cell_x(position.x) + get_cell_z(position.z)*_num_cells_x);
+}
+
+void entity_grid::move(std::uint32_t entity, const glm::vec3& position) {
+	const int cell = get_cell_x(position.x) + get_cell_z(position.z)*_num_cells_x;
+	if (cell != _cells[entity]) {
+		unlink(entity);
+		link(entity, cell);
+	}
+}
+
+void entity_grid::for_each_near(const glm::vec3& position, float radius, const std::function<void(std::uint32_t)>& f) const {
+	for_each_in_cells(
+		get_cell_x(position.x - radius), get_cell_x(position.x + radius),
+		get_cell_z(position.z - radius), get_cell_z(position.z + radius),
+		f
+	);
+}
+
+// Walks over the columns of cells, the ray passes. In every column only the cells
+// next to the part of the ray inside of the column are visited.
+void entity_grid::for_each_along(const ray& r, float range, float radius, const std::function<void(std::uint32_t)>& f) const {
+	const glm::vec3 start = r.position;
+	const glm::vec3 end = r.position + glm::normalize(r.direction) * range;
+	const float min_x = std::min(start.x, end.x) - radius;
+	const float max_x = std::max(start.x, end.x) + radius;
+	const int min_cell_x = get_cell_x(min_x);
+	const int max_cell_x = get_cell_x(max_x);
+
+	for (int cell_x = min_cell_x; cell_x <= max_cell_x; cell_x++) {
+		// the border columns also hold the entities outside of the map
+		const float column_min_x = cell_x == 0 ? min_x : std::max(cell_x*_cell_size - radius, min_x);
+		const float column_max_x = cell_x == _num_cells_x-1 ? max_x : std::min((cell_x+1)*_cell_size + radius, max_x);
+
+		float min_z = std::min(start.z, end.z);
+		float max_z = std::max(start.z, end.z);
+		if (end.x != start.x) {
+			const float t0 = std::clamp((column_min_x - start.x) / (end.x - start.x), 0.f, 1.f);
+			const float t1 = std::clamp((column_max_x - start.x) / (end.x - start.x), 0.f, 1.f);
+			const float z0 = start.z + (end.z - start.z)*t0;
+			const float z1 = start.z + (end.z - start.z)*t1;
+			min_z = std::min(z0, z1);
+			max_z = std::max(z0, z1);
+		}
+
+		for_each_in_cells(cell_x, cell_x, get_cell_z(min_z - radius), get_cell_z(max_z + radius), f);
+	}
+}
+
+int entity_grid::get_cell_x(float x) const {
+	return std::clamp(static_cast<int>(std::floor(x / _cell_size)), 0, _num_cells_x-1);
+}
+
+int entity_grid::get_cell_z(float z) const {
+	return std::clamp(static_cast<int>(std::floor(z / _cell_size)), 0, _num_cells_z-1);
+}
+
+void entity_grid::link(std::uint32_t entity, int cell) {
+	const std::int32_t head = _heads[cell];
+	_next[entity] = head;
+	_previous[entity] = -1;
+	if (head != -1) {
+		_previous[head] = entity;
+	}
+	_heads[cell] = entity;
+	_cells[entity] = cell;
+}
+
+void entity_grid::unlink(std::uint32_t entity) {
+	const std::int32_t next = _next[entity];
+	const std::int32_t previous = _previous[entity];
+	if (previous != -1) {
+		_next[previous] = next;
+	} else {
+		_heads[_cells[entity]] = next;
+	}
+	if (next != -1) {
+		_previous[next] = previous;
+	}
+}
+
+void entity_grid::for_each_in_cells(int min_x, int max_x, int min_z, int max_z, const std::function<void(std::uint32_t)>& f) const {
+	for (int z = min_z; z <= max_z; z++) {
+		for (int x = min_x; x <= max_x; x++) {
+			for (std::int32_t entity = _heads[x + z*_num_cells_x]; entity != -1; entity = _next[entity]) {
+				f(entity);
+			}
+		}
+	}
+}
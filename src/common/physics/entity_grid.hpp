@@ -0,0 +1,57 @@
+#ifndef __ENTITY_GRID_CLASS__
+#define __ENTITY_GRID_CLASS__
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include "forms.hpp"
+
+/**
+ * A uniform grid over the xz plane of the map. Every entity is linked into the cell of its position,
+ * entities outside of the map are kept in the border cells.
+ * Moving an entity only relinks it, if it changed its cell, so updating the grid every tick is cheap.
+ */
+class entity_grid {
+	public:
+		entity_grid(float cell_size, unsigned int x_size, unsigned int z_size);
+
+		void clear();
+
+		/**
+		 * Entities are numbered densely, the next inserted entity has to be the number of entities so far.
+		 */
+		void insert(std::uint32_t entity, const glm::vec3& position);
+		void move(std::uint32_t entity, const glm::vec3& position);
+
+		/**
+		 * Calls f for every entity in the cells within radius of the given position.
+		 * The caller does the exact distance check.
+		 */
+		void for_each_near(const glm::vec3& position, float radius, const std::function<void(std::uint32_t)>& f) const;
+
+		/**
+		 * Calls f for every entity in the cells within radius of the ray, from its position up to range.
+		 */
+		void for_each_along(const ray& r, float range, float radius, const std::function<void(std::uint32_t)>& f) const;
+	private:
+		int get_cell_x(float x) const;
+		int get_cell_z(float z) const;
+		void link(std::uint32_t entity, int cell);
+		void unlink(std::uint32_t entity);
+		void for_each_in_cells(int min_x, int max_x, int min_z, int max_z, const std::function<void(std::uint32_t)>& f) const;
+
+		float _cell_size;
+		int _num_cells_x;
+		int _num_cells_z;
+
+		// doubly linked list of entities per cell, -1 ends a list
+		std::vector<std::int32_t> _heads;
+		std::vector<std::int32_t> _next;
+		std::vector<std::int32_t> _previous;
+		std::vector<std::int32_t> _cells;
+};
+
+#endif
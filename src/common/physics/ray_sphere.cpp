@@ -0,0 +1,128 @@
+#include "ray_sphere.hpp"
+
+#include <cstdint>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RAY_SPHERE_AVX2
+#include <immintrin.h>
+#endif
+
+// The ray direction d is normalized. For the offset o from the start of the ray to a center,
+// t = dot(o, d) is the position of the closest point on the line, and
+// dot(o, o) - t*t is the squared distance of the center to the line.
+// The sphere is in front of the ray, if the closest point is in front of it, or the ray starts inside of it.
+
+#ifdef RAY_SPHERE_AVX2
+// Tests 8 spheres at once and returns the number of tested spheres, the rest is left to the scalar loop.
+// It is compiled for AVX2 independent of the build flags and only called, if the cpu supports it.
+__attribute__((target("avx2")))
+std::size_t find_closest_hit_sphere_avx2(
+	const ray& r,
+	const glm::vec3& direction,
+	float radius2,
+	const float* centers_x,
+	const float* centers_y,
+	const float* centers_z,
+	std::size_t n,
+	float* closest_distance2,
+	std::size_t* closest_index
+) {
+	std::size_t i = 0;
+
+	const __m256 start_x = _mm256_set1_ps(r.position.x);
+	const __m256 start_y = _mm256_set1_ps(r.position.y);
+	const __m256 start_z = _mm256_set1_ps(r.position.z);
+	const __m256 direction_x = _mm256_set1_ps(direction.x);
+	const __m256 direction_y = _mm256_set1_ps(direction.y);
+	const __m256 direction_z = _mm256_set1_ps(direction.z);
+	const __m256 radius2_8 = _mm256_set1_ps(radius2);
+	const __m256 zero = _mm256_setzero_ps();
+
+	// every lane keeps its own closest hit
+	__m256 lane_distance2 = _mm256_set1_ps(*closest_distance2);
+	__m256i lane_index = _mm256_set1_epi32(-1);
+	__m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	const __m256i index_step = _mm256_set1_epi32(8);
+
+	for (; i + 8 <= n; i += 8) {
+		const __m256 offset_x = _mm256_sub_ps(_mm256_loadu_ps(centers_x + i), start_x);
+		const __m256 offset_y = _mm256_sub_ps(_mm256_loadu_ps(centers_y + i), start_y);
+		const __m256 offset_z = _mm256_sub_ps(_mm256_loadu_ps(centers_z + i), start_z);
+
+		const __m256 t = _mm256_add_ps(
+			_mm256_add_ps(_mm256_mul_ps(offset_x, direction_x), _mm256_mul_ps(offset_y, direction_y)),
+			_mm256_mul_ps(offset_z, direction_z)
+		);
+		const __m256 distance2 = _mm256_add_ps(
+			_mm256_add_ps(_mm256_mul_ps(offset_x, offset_x), _mm256_mul_ps(offset_y, offset_y)),
+			_mm256_mul_ps(offset_z, offset_z)
+		);
+		const __m256 line_distance2 = _mm256_sub_ps(distance2, _mm256_mul_ps(t, t));
+
+		const __m256 on_line = _mm256_cmp_ps(line_distance2, radius2_8, _CMP_LE_OQ);
+		const __m256 in_front = _mm256_or_ps(_mm256_cmp_ps(t, zero, _CMP_GT_OQ), _mm256_cmp_ps(distance2, radius2_8, _CMP_LT_OQ));
+		const __m256 closer = _mm256_cmp_ps(distance2, lane_distance2, _CMP_LT_OQ);
+		const __m256 hit = _mm256_and_ps(_mm256_and_ps(on_line, in_front), closer);
+
+		lane_distance2 = _mm256_blendv_ps(lane_distance2, distance2, hit);
+		lane_index = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(lane_index), _mm256_castsi256_ps(index), hit));
+		index = _mm256_add_epi32(index, index_step);
+	}
+
+	alignas(32) float distances2[8];
+	alignas(32) std::int32_t indices[8];
+	_mm256_store_ps(distances2, lane_distance2);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(indices), lane_index);
+	for (unsigned int lane = 0; lane < 8; lane++) {
+		if (indices[lane] == -1) continue;
+		const std::size_t lane_closest = static_cast<std::size_t>(indices[lane]);
+		if (distances2[lane] < *closest_distance2 || (distances2[lane] == *closest_distance2 && lane_closest < *closest_index)) {
+			*closest_distance2 = distances2[lane];
+			*closest_index = lane_closest;
+		}
+	}
+	return i;
+}
+#endif
+
+std::optional<std::size_t> find_closest_hit_sphere(
+	const ray& r,
+	float radius,
+	float max_distance,
+	const float* centers_x,
+	const float* centers_y,
+	const float* centers_z,
+	std::size_t n
+) {
+	const glm::vec3 direction = glm::normalize(r.direction);
+	const float radius2 = radius*radius;
+
+	float closest_distance2 = max_distance*max_distance;
+	std::size_t closest_index = std::numeric_limits<std::size_t>::max();
+	std::size_t i = 0;
+
+#ifdef RAY_SPHERE_AVX2
+	static const bool has_avx2 = __builtin_cpu_supports("avx2");
+	if (has_avx2) {
+		i = find_closest_hit_sphere_avx2(r, direction, radius2, centers_x, centers_y, centers_z, n, &closest_distance2, &closest_index);
+	}
+#endif
+
+	for (; i < n; i++) {
+		const glm::vec3 offset = glm::vec3(centers_x[i], centers_y[i], centers_z[i]) - r.position;
+		const float t = glm::dot(offset, direction);
+		const float distance2 = glm::dot(offset, offset);
+		const bool on_line = distance2 - t*t <= radius2;
+		const bool in_front = t > 0.f || distance2 < radius2;
+		if (on_line && in_front && distance2 < closest_distance2) {
+			closest_distance2 = distance2;
+			closest_index = i;
+		}
+	}
+
+	if (closest_index == std::numeric_limits<std::size_t>::max()) {
+		return std::nullopt;
+	}
+	return closest_index;
+}
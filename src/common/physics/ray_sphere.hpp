@@ -0,0 +1,29 @@
+#ifndef __RAY_SPHERE_CLASS__
+#define __RAY_SPHERE_CLASS__
+
+#include <cstddef>
+#include <optional>
+
+#include "forms.hpp"
+
+/**
+ * Tests one ray against n spheres of the same radius. The centers are given as separate arrays.
+ * A sphere is hit, if the line of the ray passes through it and the sphere is not behind the
+ * start of the ray, the same as sheep::is_colliding.
+ *
+ * Returns the index of the hit sphere, whose center is closest to the start of the ray.
+ * Spheres at max_distance or further away are ignored. Ties go to the smaller index.
+ *
+ * On x86 cpus with AVX2, 8 spheres are tested at once. The cpu is checked at runtime.
+ */
+std::optional<std::size_t> find_closest_hit_sphere(
+	const ray& r,
+	float radius,
+	float max_distance,
+	const float* centers_x,
+	const float* centers_y,
+	const float* centers_z,
+	std::size_t n
+);
+
+#endif
@@ -1,6 +1,14 @@
 #include "util.hpp"
 
+#include <cmath>
+
 std::ostream& operator<<(std::ostream& stream, const glm::vec3& v) {
 	stream << '(' << v.x << ',' << v.y << ',' << v.z << ')';
 	return stream;
 }
+
+void sin_cos(float angle, float* sine, float* cosine) {
+	// the compiler merges both calls into one sincos call
+	*sine = std::sin(angle);
+	*cosine = std::cos(angle);
+}
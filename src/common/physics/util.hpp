@@ -6,4 +6,9 @@
 
 std::ostream& operator<<(std::ostream& stream, const glm::vec3& v);
 
+/**
+ * Computes sine and cosine of an angle in radians in one go.
+ */
+void sin_cos(float angle, float* sine, float* cosine);
+
 #endif
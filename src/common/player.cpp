@@ -1,5 +1,6 @@
 #include "player.hpp"
 
+#include <cmath>
 #include <iostream>
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -7,18 +8,21 @@
 
 #include "networking/actions_packet.hpp"
 #include "physics/util.hpp"
-#include "sheep.hpp"
+#include "sheep_store.hpp"
 
 const float PLAYER_ROTATE_SPEED = 0.05f;
 const glm::vec3 CAMERA_OFFSET = glm::vec3(0, 0.4f, 0);
-constexpr float GRAVITY = 0.04f;
-constexpr float PLAYER_JUMP_SPEED = 0.28f;
+// all rates are per second
+constexpr float GRAVITY = 25.f;
+constexpr float PLAYER_JUMP_SPEED = 7.f;
+constexpr float PLAYER_ACCELERATION = 62.5f;
 constexpr float PLAYER_COLLIDER_DIMENSION = 0.2f;
-constexpr float PLAYER_DRAG = 0.03f;
-constexpr float MAX_PLAYER_SPEED = 0.2f;
+constexpr float PLAYER_DRAG = 18.75f;
+constexpr float MAX_PLAYER_SPEED = 5.f;
 constexpr unsigned int NUM_BLOCKS_TO_PLACE = 20;
 constexpr unsigned int NUM_BLOCKS_TO_DESTROY = 20;
-constexpr float HOOK_DRAG = 0.7f;
+// the part of its speed, that a player hooked to a block keeps after one second
+constexpr float HOOK_SPEED_RETENTION = 1.341e-4f;
 constexpr glm::vec3 PLAYER_SIZE = glm::vec3(0.5f, 0.5f, 0.5f);
 
 player::player(unsigned int id, const std::string& name)
@@ -46,7 +50,7 @@ const glm::vec3& player::get_position() const {
 }
 
 const glm::vec2& player::get_view_angles() const {
-	return _body.view_angles;
+	return _body.get_view_angles();
 }
 
 const glm::vec3& player::get_speed() const {
@@ -94,7 +98,7 @@ void player::set_position(const glm::vec3& position) {
 }
 
 void player::set_view_angles(const glm::vec2& view_angles) {
-	_body.view_angles = view_angles;
+	_body.set_view_angles(view_angles);
 }
 
 void player::set_speed(const glm::vec3& speed) {
@@ -115,7 +119,7 @@ void player::set_hook(const std::optional<hook>& h) {
 	_hook = h;
 }
 
-void player::reset_hook(std::vector<sheep>& sheeps) {
+void player::reset_hook(sheep_store& sheeps) {
 	if (_hook) {
 		if (_hook->target_sheep_index) {
 			sheeps[*(_hook->target_sheep_index)].set_is_hooked(false);
@@ -125,20 +129,22 @@ void player::reset_hook(std::vector<sheep>& sheeps) {
 }
 
 void player::update_direction(const glm::vec2& direction_update) {
-	_body.view_angles.y += direction_update.x * PLAYER_ROTATE_SPEED;
-	_body.view_angles.x -= direction_update.y * PLAYER_ROTATE_SPEED;
-	_body.view_angles.x = fmax(fmin(_body.view_angles.x, 89.f), -89.0f);
+	glm::vec2 view_angles = _body.get_view_angles();
+	view_angles.y += direction_update.x * PLAYER_ROTATE_SPEED;
+	view_angles.x -= direction_update.y * PLAYER_ROTATE_SPEED;
+	view_angles.x = fmax(fmin(view_angles.x, 89.f), -89.0f);
+	_body.set_view_angles(view_angles);
 }
 
-glm::vec3 player::get_right() const {
+const glm::vec3& player::get_right() const {
 	return _body.get_right();
 }
 
-glm::vec3 player::get_direction() const {
+const glm::vec3& player::get_direction() const {
 	return _body.get_direction();
 }
 
-glm::vec3 player::get_top() const {
+const glm::vec3& player::get_top() const {
 	return _body.get_top();
 }
 
@@ -150,22 +156,21 @@ glm::vec3 player::get_camera_position() const {
 	return _body.position + CAMERA_OFFSET;
 }
 
-void player::respawn(const glm::vec3& position, std::vector<sheep>& sheeps) {
+void player::respawn(const glm::vec3& position, sheep_store& sheeps) {
 	_body.position = position;
 	_body.speed = glm::vec3();
-	_body.view_angles = glm::vec2();
+	_body.set_view_angles(glm::vec2());
 	reset_hook(sheeps);
 }
 
-bool player::tick(const block_container& blocks, std::vector<sheep>& sheeps) {
+bool player::tick(const block_container& blocks, sheep_store& sheeps, random_generator* random, float delta_time) {
 	if (!(_hook && _hook->target_point)) {
-		_body.speed.y -= GRAVITY;
+		_body.speed.y -= GRAVITY * delta_time;
 	}
-	apply_player_movements(blocks);
-	_body.position += _body.speed;
+	apply_player_movements(blocks, delta_time);
+	_body.physics(blocks, delta_time);
 
-	handle_hook(blocks, sheeps);
-	_body.physics(blocks);
+	handle_hook(blocks, sheeps, delta_time);
 
 	bool was_winning = false;
 
@@ -175,13 +180,13 @@ bool player::tick(const block_container& blocks, std::vector<sheep>& sheeps) {
 	}
 
 	if (_body.position.y < blocks.get_min_y() - 100.f) {
-		respawn(blocks.get_respawn_position(), sheeps);
+		respawn(blocks.get_respawn_position(random), sheeps);
 	}
 
 	return was_winning;
 }
 
-void player::apply_player_movements(const block_container& blocks) {
+void player::apply_player_movements(const block_container& blocks, float delta_time) {
 	float forward = 0;
 	if (_actions & FORWARD_ACTION)
 		forward++;
@@ -202,27 +207,27 @@ void player::apply_player_movements(const block_container& blocks) {
 
 	glm::vec3 tmp_direction = glm::normalize(glm::vec3(get_direction().x, 0.f, get_direction().z));
 
-	_body.speed += (get_right()*right + tmp_direction*forward)*0.1f;
+	_body.speed += (get_right()*right + tmp_direction*forward)*(PLAYER_ACCELERATION * delta_time);
 
 	glm::vec3 tmp_speed = _body.speed;
 
 	if (is_block_hooked()) {
-		tmp_speed *= HOOK_DRAG;
+		tmp_speed *= std::pow(HOOK_SPEED_RETENTION, delta_time);
 		_body.speed = tmp_speed;
 	} else {
-		body::apply_drag(tmp_speed, PLAYER_DRAG, MAX_PLAYER_SPEED);
+		body::apply_drag(tmp_speed, PLAYER_DRAG * delta_time, MAX_PLAYER_SPEED);
 		_body.speed.x = tmp_speed.x;
 		_body.speed.z = tmp_speed.z;
 	}
 }
 
-void player::physics(const block_container& blocks) {
-	_body.physics(blocks);
+void player::physics(const block_container& blocks, float delta_time) {
+	_body.physics(blocks, delta_time);
 }
 
-void player::handle_active_hook(const block_container& blocks, std::vector<sheep>& sheeps) {
+void player::handle_active_hook(const block_container& blocks, sheep_store& sheeps, float delta_time) {
 	if (!_hook->is_hooked()) {
-		_hook->range += HOOK_SPEED;
+		_hook->range += HOOK_SPEED * delta_time;
 		_hook->check_target(blocks, sheeps, _hook_range);
 		if ((!_hook->is_hooked()) && _hook->range >= _hook_range) {
 			reset_hook(sheeps);
@@ -232,22 +237,22 @@ void player::handle_active_hook(const block_container& blocks, std::vector<sheep
 	if (_hook) {
 		if (_hook->target_point) {
 			const glm::vec3 hook_direction = glm::normalize(*(_hook->target_point) - _body.position);
-			_body.speed += hook_direction*HOOK_ACCELERATION;
+			_body.speed += hook_direction*(HOOK_ACCELERATION * delta_time);
 		} else if (_hook->target_sheep_index) {
-			sheep& target_sheep = sheeps[*(_hook->target_sheep_index)];
+			sheep target_sheep = sheeps[*(_hook->target_sheep_index)];
 			const glm::vec3 hook_direction = glm::normalize(_body.position - target_sheep.get_position());
-			target_sheep.accelerate(hook_direction * HOOK_ACCELERATION);
+			target_sheep.accelerate(hook_direction * (HOOK_ACCELERATION * delta_time));
 		}
 	}
 }
 
-void player::handle_hook(const block_container& blocks, std::vector<sheep>& sheeps) {
+void player::handle_hook(const block_container& blocks, sheep_store& sheeps, float delta_time) {
 	if (!_hook && _actions & HOOK_ACTION) {
 		_hook = hook(get_camera_position(), get_direction());
 	}
 	if (_hook) {
 		if (_actions & HOOK_ACTION) {
-			handle_active_hook(blocks, sheeps);
+			handle_active_hook(blocks, sheeps, delta_time);
 		} else {
 			reset_hook(sheeps);
 		}
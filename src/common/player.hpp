@@ -9,6 +9,7 @@
 #include "physics/forms.hpp"
 #include "physics/body.hpp"
 #include "hook.hpp"
+#include "random_generator.hpp"
 
 class player {
 	public:
@@ -35,21 +36,21 @@ class player {
 		void set_speed(const glm::vec3& speed);
 		void set_actions(const std::uint16_t actions);
 		void set_hook(const std::optional<hook>& h);
-		void reset_hook(std::vector<sheep>& sheeps);
+		void reset_hook(sheep_store& sheeps);
 		void update_direction(const glm::vec2& direction_update);
 
-		glm::vec3 get_right() const;
-		glm::vec3 get_direction() const;
-		glm::vec3 get_top() const;
+		const glm::vec3& get_right() const;
+		const glm::vec3& get_direction() const;
+		const glm::vec3& get_top() const;
 		glm::mat4 get_look_at() const;
 		glm::vec3 get_camera_position() const;
 
-		void respawn(const glm::vec3& position, std::vector<sheep>& sheeps);
-		bool tick(const block_container& blocks, std::vector<sheep>& sheeps);
-		void apply_player_movements(const block_container& blocks);
-		void physics(const block_container& blocks);
-		void handle_hook(const block_container& blocks, std::vector<sheep>& sheeps);
-		void handle_active_hook(const block_container& blocks, std::vector<sheep>& sheeps);
+		void respawn(const glm::vec3& position, sheep_store& sheeps);
+		bool tick(const block_container& blocks, sheep_store& sheeps, random_generator* random, float delta_time);
+		void apply_player_movements(const block_container& blocks, float delta_time);
+		void physics(const block_container& blocks, float delta_time);
+		void handle_hook(const block_container& blocks, sheep_store& sheeps, float delta_time);
+		void handle_active_hook(const block_container& blocks, sheep_store& sheeps, float delta_time);
 	private:
 		char _id;
 
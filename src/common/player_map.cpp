@@ -0,0 +1,82 @@
+#include "player_map.hpp"
+
+constexpr std::uint16_t NO_PLAYER = 0xffff;
+
+player_map::player_map() {
+	_indices.fill(NO_PLAYER);
+}
+
+std::size_t player_map::size() const {
+	return _players.size();
+}
+
+bool player_map::empty() const {
+	return _players.empty();
+}
+
+player* player_map::get(char player_id) {
+	const std::uint16_t index = _indices[slot(player_id)];
+	if (index == NO_PLAYER) {
+		return nullptr;
+	}
+	return &_players[index];
+}
+
+const player* player_map::get(char player_id) const {
+	const std::uint16_t index = _indices[slot(player_id)];
+	if (index == NO_PLAYER) {
+		return nullptr;
+	}
+	return &_players[index];
+}
+
+player& player_map::insert(const player& p) {
+	std::uint16_t& index = _indices[slot(p.get_id())];
+	if (index != NO_PLAYER) {
+		_players[index] = p;
+	} else {
+		index = _players.size();
+		_players.push_back(p);
+	}
+	return _players[index];
+}
+
+bool player_map::erase(char player_id) {
+	const std::uint16_t index = _indices[slot(player_id)];
+	if (index == NO_PLAYER) {
+		return false;
+	}
+
+	if (index != _players.size() - 1) {
+		_players[index] = std::move(_players.back());
+		_indices[slot(_players[index].get_id())] = index;
+	}
+	_players.pop_back();
+	_indices[slot(player_id)] = NO_PLAYER;
+	return true;
+}
+
+void player_map::clear() {
+	_players.clear();
+	_indices.fill(NO_PLAYER);
+}
+
+player_map::iterator player_map::begin() {
+	return _players.begin();
+}
+
+player_map::iterator player_map::end() {
+	return _players.end();
+}
+
+player_map::const_iterator player_map::begin() const {
+	return _players.begin();
+}
+
+player_map::const_iterator player_map::end() const {
+	return _players.end();
+}
+
+std::size_t player_map::slot(char player_id) {
+	return static_cast<unsigned char>(player_id);
+}
@@ -0,0 +1,55 @@
+#ifndef __PLAYER_MAP_CLASS__
+#define __PLAYER_MAP_CLASS__
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "player.hpp"
+
+// player ids are sent as one byte
+constexpr std::size_t MAX_PLAYER_IDS = 256;
+
+/**
+ * Holds the players of a frame densely, so they can be iterated in order for ticking and serialization.
+ * A table indexed by the player id points into the dense array, so players are found and removed in constant time.
+ * Removing a player moves the last player into its place.
+ */
+class player_map {
+	public:
+		using iterator = std::vector<player>::iterator;
+		using const_iterator = std::vector<player>::const_iterator;
+
+		player_map();
+
+		std::size_t size() const;
+		bool empty() const;
+
+		/**
+		 * Returns nullptr, if there is no player with the given id.
+		 */
+		player* get(char player_id);
+		const player* get(char player_id) const;
+
+		/**
+		 * Adds the given player. A player with the same id is replaced.
+		 */
+		player& insert(const player& p);
+		/**
+		 * Returns false, if there is no player with the given id.
+		 */
+		bool erase(char player_id);
+		void clear();
+
+		iterator begin();
+		iterator end();
+		const_iterator begin() const;
+		const_iterator end() const;
+	private:
+		static std::size_t slot(char player_id);
+
+		std::vector<player> _players;
+		std::array<std::uint16_t, MAX_PLAYER_IDS> _indices;
+};
+
+#endif
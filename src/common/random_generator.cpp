@@ -0,0 +1,27 @@
+#include "random_generator.hpp"
+
+// PCG32 by Melissa O'Neill, see https://www.pcg-random.org
+
+constexpr std::uint64_t PCG_MULTIPLIER = 6364136223846793005ULL;
+
+random_generator::random_generator() : random_generator(0, 0) {}
+
+random_generator::random_generator(std::uint64_t seed, std::uint64_t stream)
+	: _state(0), _increment((stream << 1u) | 1u)
+{
+	next();
+	_state += seed;
+	next();
+}
+
+std::uint32_t random_generator::next() {
+	const std::uint64_t old_state = _state;
+	_state = old_state * PCG_MULTIPLIER + _increment;
+	const std::uint32_t xor_shifted = static_cast<std::uint32_t>(((old_state >> 18u) ^ old_state) >> 27u);
+	const std::uint32_t rotation = static_cast<std::uint32_t>(old_state >> 59u);
+	return (xor_shifted >> rotation) | (xor_shifted << ((-rotation) & 31u));
+}
+
+std::uint32_t random_generator::next(std::uint32_t bound) {
+	return next() % bound;
+}
@@ -0,0 +1,29 @@
+#ifndef __RANDOM_GENERATOR_CLASS__
+#define __RANDOM_GENERATOR_CLASS__
+
+#include <cstdint>
+
+/**
+ * A small PCG32 random number generator.
+ *
+ * Every generator owns its state, so entities with their own generator can be
+ * simulated in any order or in parallel and still produce the same numbers.
+ * Generators with the same seed but different streams produce independent sequences.
+ */
+class random_generator {
+	public:
+		random_generator();
+		random_generator(std::uint64_t seed, std::uint64_t stream);
+
+		std::uint32_t next();
+
+		/**
+		 * Returns a number in [0, bound).
+		 */
+		std::uint32_t next(std::uint32_t bound);
+	private:
+		std::uint64_t _state;
+		std::uint64_t _increment;
+};
+
+#endif
@@ -8,56 +8,68 @@
 #include <glm/gtx/vector_angle.hpp>
 #include <glm/gtx/intersect.hpp>
 
+#include "sheep_store.hpp"
+#include "physics/util.hpp"
 #include "world/block_container.hpp"
 
-constexpr float GRAVITY = 0.04f;
-constexpr float SHEEP_DRAG = 0.03f;
-constexpr float MAX_SHEEP_SPEED = 0.04f;
-constexpr float MAX_SHEEP_SPEED_HOOKED = 0.3f;
-constexpr float MAX_SHEEP_SPEED_JUMP = 0.2f;
-constexpr float SHEEP_ACCELERATION = 0.03f;
-constexpr float SHEEP_JUMP_ACCELERATION = 0.07f;
-constexpr float SHEEP_JUMP_SPEED = 0.3f;
-constexpr float TURN_SPEED = 0.15f;
-constexpr unsigned int JUMP_DURATION = 5;
-
-sheep::sheep() : _state(sheep_state::WAIT), _state_counter(0), _forward(0.f), _jump(0), _is_hooked(false) {}
-
-sheep::sheep(const glm::vec3& position, float yaw)
-	:   _body(
-			position,
-			glm::vec3(0.45f, 0.5f, 0.35f),
-			glm::vec3(0.01f, 0.0f, 0.0f),
-			glm::vec2(0.f, yaw),
-			0.3f
-		),
-		_state(sheep_state::WAIT),
-		_state_counter(0),
-		_forward(1.0f),
-		_turn(0.4f),
-		_jump(0),
-		_is_hooked(false)
-{}
-
-const glm::vec3& sheep::get_position() const {
-	return _body.position;
+// all rates are per second
+constexpr float SHEEP_ACCELERATION = 18.75f;
+constexpr float SHEEP_JUMP_ACCELERATION = 43.75f;
+constexpr float SHEEP_JUMP_SPEED = 7.5f;
+constexpr float SHEEP_TURN_SPEED = 25.f; // degrees per second
+constexpr float JUMP_DURATION = 0.2f;
+constexpr float MIN_STATE_DURATION = 0.8f;
+constexpr float STATE_DURATION_STEP = 0.04f;
+constexpr unsigned int NUM_STATE_DURATION_STEPS = 15;
+
+const glm::vec3 SHEEP_SIZE(0.45f, 0.5f, 0.35f);
+constexpr float SHEEP_COLLIDER_DIMENSION = 0.3f;
+constexpr float SLEEP_SPEED = 0.125f;
+
+sheep::sheep(sheep_store* store, std::size_t index) : _store(store), _index(index) {}
+
+glm::vec3 sheep::get_position() const {
+	return glm::vec3(_store->_position_x[_index], _store->_position_y[_index], _store->_position_z[_index]);
 }
 
 float sheep::get_yaw() const {
-	return _body.view_angles.y;
+	return _store->_yaw[_index];
+}
+
+glm::vec3 sheep::get_direction() const {
+	return glm::vec3(_store->_direction_x[_index], 0.f, _store->_direction_z[_index]);
 }
 
 bool sheep::is_hooked() const {
-	return _is_hooked;
+	return _store->_is_hooked[_index];
+}
+
+bool sheep::is_asleep() const {
+	return _store->_asleep[_index];
 }
 
 void sheep::set_is_hooked(bool h) {
-	_is_hooked = h;
+	_store->_is_hooked[_index] = h;
+	if (h) {
+		wake_up();
+	}
+}
+
+void sheep::set_yaw(float yaw) {
+	float sin_yaw, cos_yaw;
+	sin_cos(glm::radians(yaw), &sin_yaw, &cos_yaw);
+	_store->_yaw[_index] = yaw;
+	_store->_direction_x[_index] = cos_yaw;
+	_store->_direction_z[_index] = sin_yaw;
+}
+
+void sheep::wake_up() {
+	_store->_asleep[_index] = false;
 }
 
 bool sheep::is_colliding(const ray& r, float range) const {
 	glm::vec3 intersection_position, intersection_normal, intersection_position2, intersection_normal2;
-	bool intersect = glm::intersectLineSphere(r.position, r.position + glm::normalize(r.direction) * range, _body.position, 0.5f, intersection_position, intersection_normal, intersection_position2, intersection_normal2);
+	bool intersect = glm::intersectLineSphere(r.position, r.position + glm::normalize(r.direction) * range, get_position(), SHEEP_HIT_RADIUS, intersection_position, intersection_normal, intersection_position2, intersection_normal2);
 	if (intersect) {
 		return glm::dot(r.direction, intersection_position - r.position) > 0.f;
 	}
@@ -65,69 +77,60 @@ bool sheep::is_colliding(const ray& r, float range) const {
 }
 
 void sheep::accelerate(const glm::vec3& acceleration) {
-	_body.speed += acceleration;
+	wake_up();
+	_store->_speed_x[_index] += acceleration.x;
+	_store->_speed_y[_index] += acceleration.y;
+	_store->_speed_z[_index] += acceleration.z;
 }
 
-void sheep::tick(const block_container& blocks) {
-	if (_is_hooked) {
-		_body.speed.y -= GRAVITY*0.4f;
-	} else {
-		_body.speed.y -= GRAVITY;
-	}
-	think(blocks);
-	apply_movements(blocks);
-
-	glm::vec3 tmp_speed(_body.speed);
-
-	float max_sheep_speed = MAX_SHEEP_SPEED;
-	float sheep_drag = SHEEP_DRAG;
-	if (_is_hooked) {
-		max_sheep_speed = MAX_SHEEP_SPEED_HOOKED;
-		sheep_drag *= 0.2f;
-	} else if (_jump) {
-		max_sheep_speed = MAX_SHEEP_SPEED_JUMP;
+void sheep::apply_movements(const block_container& blocks, float delta_time) {
+	if (_store->_turn[_index] != 0.f) {
+		set_yaw(get_yaw() + _store->_turn[_index] * SHEEP_TURN_SPEED * delta_time);
 	}
-
-	body::apply_drag(tmp_speed, sheep_drag, max_sheep_speed);
-	if (_is_hooked) {
-		_body.speed = tmp_speed;
-	} else {
-		_body.speed.x = tmp_speed.x;
-		_body.speed.z = tmp_speed.z;
-	}
-	_body.position += _body.speed;
-	_body.physics(blocks);
-
-	if (_body.position.y < blocks.get_min_y() - 100.f) {
-		respawn(blocks);
-	}
-}
-
-void sheep::apply_movements(const block_container& blocks) {
-	_body.view_angles.y += _turn;
+	float& jump_time = _store->_jump_time[_index];
 	float sheep_acceleration = SHEEP_ACCELERATION;
-	if (_jump) {
+	if (jump_time > 0.f) {
 		sheep_acceleration = SHEEP_JUMP_ACCELERATION;
 	}
-	_body.speed += _body.get_direction() * (_forward * sheep_acceleration);
+	accelerate(get_direction() * (_store->_forward[_index] * sheep_acceleration * delta_time));
 
-	if (_jump) {
-		if (_jump == JUMP_DURATION) {
-			if (!blocks.get_colliding_blocks(_body.get_bottom_collider()).empty()) {
-				_body.speed.y = SHEEP_JUMP_SPEED;
+	if (jump_time > 0.f) {
+		// the sheep leaps in the first tick of the jump
+		if (jump_time == JUMP_DURATION) {
+			if (!blocks.get_colliding_blocks(get_body().get_bottom_collider()).empty()) {
+				_store->_speed_y[_index] = SHEEP_JUMP_SPEED;
 			}
 		}
-		_jump--;
+		jump_time = glm::max(jump_time - delta_time, 0.f);
+	}
+}
+
+void sheep::physics(const block_container& blocks, float delta_time) {
+	body b = get_body();
+	const bool falling = b.speed.y < 0.f;
+	b.physics(blocks, delta_time);
+	set_body(b);
+	// the ground stopped the fall
+	const bool landed = falling && b.speed.y == 0.f;
+
+	if (b.position.y < blocks.get_min_y() - 100.f) {
+		respawn(blocks);
+	} else if (landed && should_sleep(b)) {
+		_store->_speed_x[_index] = 0.f;
+		_store->_speed_y[_index] = 0.f;
+		_store->_speed_z[_index] = 0.f;
+		_store->_asleep[_index] = true;
 	}
 }
 
 void sheep::respawn(const block_container& blocks) {
-	_body.position = blocks.get_sheep_respawn_position();
-	_body.speed = glm::vec3();
+	const glm::vec3 position = blocks.get_sheep_respawn_position(&_store->_random[_index]);
+	set_body(body(position, SHEEP_SIZE, glm::vec3(), glm::vec2(0.f, get_yaw()), SHEEP_COLLIDER_DIMENSION));
 }
 
-void sheep::think(const block_container& blocks) {
-	switch (_state) {
+void sheep::think(const block_container& blocks, float elapsed_time) {
+	_store->_state_time[_index] -= elapsed_time;
+	switch (_store->_state[_index]) {
 		case sheep_state::WAIT:
 			wait();
 			break;
@@ -142,74 +145,94 @@ void sheep::think(const block_container& blocks) {
 			break;
 	}
 
-	if (_body.position.x < 5.f && _body.get_direction().x < 0.f) {
-		reset_state_counter();
-		_turn = 1.f;
-		_forward = 0.f;
-		_state = sheep_state::TURN;
-	} else if (_body.position.x > MAP_X_SIZE - 5.f && _body.get_direction().x > 0.f) {
-		reset_state_counter();
-		_turn = 1.f;
-		_forward = 0.f;
-		_state = sheep_state::TURN;
-	} else if (_body.position.z < 5.f && _body.get_direction().z < 0.f) {
-		reset_state_counter();
-		_turn = 1.f;
-		_forward = 0.f;
-		_state = sheep_state::TURN;
-	} else if (_body.position.z > MAP_Z_SIZE - 5.f && _body.get_direction().z > 0.f) {
-		reset_state_counter();
-		_turn = 1.f;
-		_forward = 0.f;
-		_state = sheep_state::TURN;
+	const glm::vec3 position = get_position();
+	const glm::vec3 direction = get_direction();
+	if ((position.x < 5.f && direction.x < 0.f)
+		|| (position.x > MAP_X_SIZE - 5.f && direction.x > 0.f)
+		|| (position.z < 5.f && direction.z < 0.f)
+		|| (position.z > MAP_Z_SIZE - 5.f && direction.z > 0.f))
+	{
+		start_turn(1.f);
 	}
-	_state_counter--;
 }
 
 void sheep::wait() {
-	if (_state_counter <= 0) {
+	if (_store->_state_time[_index] <= 0.f) {
 		start_move();
 	}
 }
 
 void sheep::move(const block_container& blocks) {
-	if (_state_counter <= 0) {
+	if (_store->_state_time[_index] <= 0.f) {
 		start_turn();
 	} else {
-		std::optional<world_block> front_block = blocks.get_colliding_block(ray(_body.position, _body.get_direction()), 0.7f);
+		std::optional<world_block> front_block = blocks.get_colliding_block(ray(get_position(), get_direction()), 0.7f);
 		if (front_block) {
-			_jump = JUMP_DURATION;
+			_store->_jump_time[_index] = JUMP_DURATION;
 		}
 	}
 }
 
 void sheep::turn() {
-	if (_state_counter <= 0) {
+	if (_store->_state_time[_index] <= 0.f) {
 		start_wait();
 	}
 }
 
 void sheep::start_wait() {
-	reset_state_counter();
-	_turn = 0.f;
-	_forward = 0.f;
-	_state = sheep_state::WAIT;
+	reset_state_time();
+	_store->_turn[_index] = 0.f;
+	_store->_forward[_index] = 0.f;
+	_store->_state[_index] = sheep_state::WAIT;
+	wake_up();
 }
 
 void sheep::start_move() {
-	reset_state_counter();
-	_turn = 0.f;
-	_forward = 1.f;
-	_state = sheep_state::MOVE;
+	reset_state_time();
+	_store->_turn[_index] = 0.f;
+	_store->_forward[_index] = 1.f;
+	_store->_state[_index] = sheep_state::MOVE;
+	wake_up();
 }
 
 void sheep::start_turn() {
-	reset_state_counter();
-	_turn = (rand() % 2) * 2 - 1;
-	_forward = 0.f;
-	_state = sheep_state::TURN;
+	start_turn(static_cast<float>(_store->_random[_index].next(2)) * 2.f - 1.f);
+}
+
+void sheep::start_turn(float direction) {
+	reset_state_time();
+	_store->_turn[_index] = direction;
+	_store->_forward[_index] = 0.f;
+	_store->_state[_index] = sheep_state::TURN;
+	wake_up();
+}
+
+void sheep::reset_state_time() {
+	_store->_state_time[_index] = MIN_STATE_DURATION + _store->_random[_index].next(NUM_STATE_DURATION_STEPS) * STATE_DURATION_STEP;
+}
+
+body sheep::get_body() const {
+	return body(
+		get_position(),
+		SHEEP_SIZE,
+		glm::vec3(_store->_speed_x[_index], _store->_speed_y[_index], _store->_speed_z[_index]),
+		glm::vec2(0.f, get_yaw()),
+		SHEEP_COLLIDER_DIMENSION
+	);
+}
+
+// A waiting sheep, that stands still on the ground, does not need physics until something happens.
+bool sheep::should_sleep(const body& b) const {
+	return _store->_state[_index] == sheep_state::WAIT
+		&& !is_hooked()
+		&& glm::length2(b.speed) < SLEEP_SPEED*SLEEP_SPEED;
 }
 
-void sheep::reset_state_counter() {
-	_state_counter = 20 + rand() % 15;
+void sheep::set_body(const body& b) {
+	_store->_position_x[_index] = b.position.x;
+	_store->_position_y[_index] = b.position.y;
+	_store->_position_z[_index] = b.position.z;
+	_store->_speed_x[_index] = b.speed.x;
+	_store->_speed_y[_index] = b.speed.y;
+	_store->_speed_z[_index] = b.speed.z;
 }
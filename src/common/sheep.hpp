@@ -1,6 +1,7 @@
 #ifndef __SHEEP_CLASS__
 #define __SHEEP_CLASS__
 
+#include <cstdint>
 #include <optional>
 
 #include <glm/vec3.hpp>
@@ -8,30 +9,50 @@
 
 #include "physics/body.hpp"
 
-enum class sheep_state {
+class block_container;
+class sheep_store;
+
+// the radius of the sphere, that hooks hit
+constexpr float SHEEP_HIT_RADIUS = 0.5f;
+
+enum class sheep_state : std::uint8_t {
 	WAIT,
 	MOVE,
 	TURN
 };
 
+/**
+ * A view on one sheep inside a sheep_store.
+ * It is cheap to copy and stays valid as long as the sheep is part of the store.
+ */
 class sheep {
 	public:
-		sheep();
-		sheep(const glm::vec3& position, float yaw);
+		sheep(sheep_store* store, std::size_t index);
 
-		const glm::vec3& get_position() const;
+		glm::vec3 get_position() const;
 		float get_yaw() const;
+		glm::vec3 get_direction() const;
 		bool is_hooked() const;
+		bool is_asleep() const;
 
+		/**
+		 * Hooking a sheep wakes it up.
+		 */
 		void set_is_hooked(bool h);
+		void set_yaw(float yaw);
+		void wake_up();
 
 		bool is_colliding(const ray& r, float range) const;
 
 		void accelerate(const glm::vec3& acceleration);
-		void tick(const block_container& blocks);
-		void apply_movements(const block_container& blocks);
+		void apply_movements(const block_container& blocks, float delta_time);
+		void physics(const block_container& blocks, float delta_time);
 		void respawn(const block_container& blocks);
-		void think(const block_container& blocks);
+		/**
+		 * Updates the decisions of the sheep. Sheep do not think every tick,
+		 * so the timers of the states are counted down by the seconds since the last call.
+		 */
+		void think(const block_container& blocks, float elapsed_time);
 
 		void wait();
 		void move(const block_container& blocks);
@@ -40,17 +61,19 @@ class sheep {
 		void start_wait();
 		void start_move();
 		void start_turn();
+		/**
+		 * The yaw changes in the sign of the direction, which is -1 or 1.
+		 */
+		void start_turn(float direction);
 
-		void reset_state_counter();
+		void reset_state_time();
 	private:
-		body _body;
-		sheep_state _state;
-		int _state_counter;
-
-		float _forward;
-		float _turn;
-		unsigned int _jump;
-		bool _is_hooked;
+		body get_body() const;
+		void set_body(const body& b);
+		bool should_sleep(const body& b) const;
+
+		sheep_store* _store;
+		std::size_t _index;
 };
 
 #endif
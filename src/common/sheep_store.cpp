@@ -0,0 +1,355 @@
+#include "sheep_store.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "thread_pool.hpp"
+#include "physics/ray_sphere.hpp"
+#include "world/block_container.hpp"
+
+// all rates are per second
+constexpr float GRAVITY = 25.f;
+constexpr float HOOKED_GRAVITY_FACTOR = 0.4f;
+constexpr float SHEEP_DRAG = 18.75f;
+constexpr float HOOKED_DRAG_FACTOR = 0.2f;
+constexpr float MAX_SHEEP_SPEED = 1.f;
+constexpr float MAX_SHEEP_SPEED_HOOKED = 7.5f;
+constexpr float MAX_SHEEP_SPEED_JUMP = 5.f;
+constexpr float INITIAL_SHEEP_SPEED = 0.25f;
+
+constexpr std::size_t DEFAULT_AI_BUDGET = 1000;
+// sheep further away from every player than this can move at a reduced rate
+constexpr float FAR_PHYSICS_DISTANCE = 32.f;
+
+constexpr float GRID_CELL_SIZE = 1.f;
+// sheep closer to each other than this are pushed apart
+constexpr float SEPARATION_DISTANCE = 0.7f;
+constexpr float SEPARATION_STIFFNESS = 125.f;
+constexpr float PUSH_STIFFNESS = 62.5f;
+
+// iterator
+sheep_store::iterator::iterator(const sheep_store* store, std::size_t index) : _store(store), _index(index) {}
+
+sheep sheep_store::iterator::operator*() const {
+	return (*_store)[_index];
+}
+
+sheep_store::iterator& sheep_store::iterator::operator++() {
+	_index++;
+	return *this;
+}
+
+bool sheep_store::iterator::operator!=(const iterator& other) const {
+	return _index != other._index;
+}
+
+// sheep store
+sheep_store::sheep_store()
+	: _grid(GRID_CELL_SIZE, MAP_X_SIZE, MAP_Z_SIZE), _num_ticks(0), _ai_cursor(0), _ai_budget(DEFAULT_AI_BUDGET),
+	  _ai_interval(DEFAULT_AI_INTERVAL), _far_physics_interval(1)
+{}
+
+std::size_t sheep_store::size() const {
+	return _yaw.size();
+}
+
+bool sheep_store::empty() const {
+	return _yaw.empty();
+}
+
+sheep sheep_store::add(const glm::vec3& position, float yaw) {
+	return add(position, yaw, random_generator());
+}
+
+sheep sheep_store::add(const glm::vec3& position, float yaw, const random_generator& random) {
+	_position_x.push_back(position.x);
+	_position_y.push_back(position.y);
+	_position_z.push_back(position.z);
+	_speed_x.push_back(INITIAL_SHEEP_SPEED);
+	_speed_y.push_back(0.f);
+	_speed_z.push_back(0.f);
+	_yaw.push_back(yaw);
+	_direction_x.push_back(0.f);
+	_direction_z.push_back(0.f);
+
+	_state.push_back(sheep_state::WAIT);
+	_state_time.push_back(0.f);
+	_forward.push_back(1.f);
+	_turn.push_back(0.4f);
+	_jump_time.push_back(0.f);
+	_is_hooked.push_back(false);
+	_asleep.push_back(false);
+	_step_time.push_back(0.f);
+	_last_think_tick.push_back(_num_ticks);
+	_random.push_back(random);
+
+	_grid.insert(size() - 1, position);
+
+	sheep s(this, size() - 1);
+	s.set_yaw(yaw);
+	return s;
+}
+
+void sheep_store::clear() {
+	_position_x.clear();
+	_position_y.clear();
+	_position_z.clear();
+	_speed_x.clear();
+	_speed_y.clear();
+	_speed_z.clear();
+	_yaw.clear();
+	_direction_x.clear();
+	_direction_z.clear();
+
+	_state.clear();
+	_state_time.clear();
+	_forward.clear();
+	_turn.clear();
+	_jump_time.clear();
+	_is_hooked.clear();
+	_asleep.clear();
+	_last_think_tick.clear();
+	_awake.clear();
+	_step_time.clear();
+	_grid.clear();
+	_ai_cursor = 0;
+	_random.clear();
+}
+
+sheep sheep_store::operator[](std::size_t index) {
+	return sheep(this, index);
+}
+
+const sheep sheep_store::operator[](std::size_t index) const {
+	// the returned view is const, so the store is not modified through it
+	return sheep(const_cast<sheep_store*>(this), index);
+}
+
+sheep_store::iterator sheep_store::begin() const {
+	return iterator(this, 0);
+}
+
+sheep_store::iterator sheep_store::end() const {
+	return iterator(this, size());
+}
+
+void sheep_store::tick(const block_container& blocks, thread_pool* pool, float delta_time) {
+	const std::function<void(std::size_t)> think = [this, &blocks, delta_time](std::size_t i) {
+		const std::size_t index = (_ai_cursor + i) % size();
+		sheep(this, index).think(blocks, static_cast<float>(_num_ticks - _last_think_tick[index]) * delta_time);
+		_last_think_tick[index] = _num_ticks;
+	};
+	// no sheep moves in this phase, so the positions of the other sheep can be read
+	const std::function<void(std::size_t)> move = [this, &blocks](std::size_t i) {
+		const float step_time = _step_time[_awake[i]];
+		if (step_time == 0.f) return;
+		sheep(this, _awake[i]).apply_movements(blocks, step_time);
+		separate(_awake[i], step_time);
+	};
+	const std::function<void(std::size_t)> collide = [this, &blocks](std::size_t i) {
+		const float step_time = _step_time[_awake[i]];
+		if (step_time == 0.f) return;
+		sheep(this, _awake[i]).physics(blocks, step_time);
+	};
+
+	_num_ticks++;
+	// a thinking sheep can wake up, so the sheep think before the awake sheep are collected
+	const std::size_t num_thinking = get_num_thinking();
+	if (pool) {
+		pool->parallel_for(num_thinking, think);
+	} else {
+		for (std::size_t i = 0; i < num_thinking; i++) think(i);
+	}
+	if (!empty()) {
+		_ai_cursor = (_ai_cursor + num_thinking) % size();
+	}
+
+	collect_awake(delta_time);
+	apply_gravity();
+	if (pool) {
+		pool->parallel_for(_awake.size(), move);
+	} else {
+		for (std::size_t i = 0; i < _awake.size(); i++) move(i);
+	}
+	apply_drag();
+	if (pool) {
+		pool->parallel_for(_awake.size(), collide);
+	} else {
+		for (std::size_t i = 0; i < _awake.size(); i++) collide(i);
+	}
+	update_grid();
+}
+
+void sheep_store::wake_up_near(const glm::vec3& position, float range) {
+	_grid.for_each_near(position, range, [this, &position, range](std::uint32_t i) {
+		const glm::vec3 offset = get_position(i) - position;
+		if (glm::dot(offset, offset) < range*range) {
+			_asleep[i] = false;
+		}
+	});
+}
+
+void sheep_store::push_away(const glm::vec3& position, float range, float delta_time) {
+	_grid.for_each_near(position, range, [this, &position, range, delta_time](std::uint32_t i) {
+		glm::vec3 offset = get_position(i) - position;
+		offset.y = 0.f;
+		const float distance = glm::length(offset);
+		if (distance < range && distance > 0.f) {
+			sheep(this, i).accelerate(offset * ((range - distance) / distance * PUSH_STIFFNESS * delta_time));
+		}
+	});
+}
+
+std::optional<std::size_t> sheep_store::get_colliding_sheep(const ray& r, float range, float max_distance) const {
+	// the sheep near the ray are packed, so they can be tested in one batch
+	std::vector<std::uint32_t> candidates;
+	std::vector<float> candidates_x, candidates_y, candidates_z;
+
+	// sheep further away than max_distance can not be hit
+	const float query_range = std::min(range, max_distance + SHEEP_HIT_RADIUS);
+	_grid.for_each_along(r, query_range, SHEEP_HIT_RADIUS, [&](std::uint32_t i) {
+		candidates.push_back(i);
+		candidates_x.push_back(_position_x[i]);
+		candidates_y.push_back(_position_y[i]);
+		candidates_z.push_back(_position_z[i]);
+	});
+
+	std::optional<std::size_t> hit = find_closest_hit_sphere(
+		r, SHEEP_HIT_RADIUS, max_distance,
+		candidates_x.data(), candidates_y.data(), candidates_z.data(), candidates.size()
+	);
+	if (hit) {
+		return candidates[*hit];
+	}
+	return std::nullopt;
+}
+
+void sheep_store::set_ai_budget(std::size_t ai_budget) {
+	_ai_budget = ai_budget;
+}
+
+void sheep_store::set_ai_interval(std::size_t ai_interval) {
+	_ai_interval = ai_interval;
+}
+
+void sheep_store::set_far_physics_interval(unsigned int far_physics_interval) {
+	_far_physics_interval = far_physics_interval;
+}
+
+void sheep_store::set_player_positions(const std::vector<glm::vec3>& player_positions) {
+	_player_positions = player_positions;
+}
+
+std::size_t sheep_store::get_num_awake() const {
+	return _awake.size();
+}
+
+std::size_t sheep_store::get_num_thinking() const {
+	const std::size_t num_per_interval = (size() + _ai_interval - 1) / _ai_interval;
+	return std::min(num_per_interval, _ai_budget);
+}
+
+// Sheep only push themselves away from the others. Sleeping sheep do not move,
+// so a sheep walking into a sleeping one is pushed back alone.
+void sheep_store::separate(std::size_t index, float delta_time) {
+	const glm::vec3 position = get_position(index);
+	glm::vec3 push(0.f);
+	_grid.for_each_near(position, SEPARATION_DISTANCE, [this, index, &position, &push](std::uint32_t other) {
+		if (other == index) return;
+		glm::vec3 offset = position - get_position(other);
+		if (glm::abs(offset.y) > 1.f) return;
+		offset.y = 0.f;
+		const float distance = glm::length(offset);
+		if (distance == 0.f) {
+			// sheep on the same spot are split along x by their index
+			push.x += index < other ? SEPARATION_DISTANCE : -SEPARATION_DISTANCE;
+		} else if (distance < SEPARATION_DISTANCE) {
+			push += offset * ((SEPARATION_DISTANCE - distance) / distance);
+		}
+	});
+	_speed_x[index] += push.x * SEPARATION_STIFFNESS * delta_time;
+	_speed_z[index] += push.z * SEPARATION_STIFFNESS * delta_time;
+}
+
+void sheep_store::update_grid() {
+	for (std::uint32_t i : _awake) {
+		_grid.move(i, get_position(i));
+	}
+}
+
+glm::vec3 sheep_store::get_position(std::size_t index) const {
+	return glm::vec3(_position_x[index], _position_y[index], _position_z[index]);
+}
+
+// Sleeping sheep still think, when it is their turn. They wake up, when their wait is over.
+// Far sheep are spread over the ticks of the far physics interval by their index.
+void sheep_store::collect_awake(float delta_time) {
+	_awake.clear();
+	const bool reduced = _far_physics_interval > 1;
+	for (std::size_t i = 0; i < size(); i++) {
+		float step_time = 0.f;
+		if (!_asleep[i]) {
+			_awake.push_back(i);
+			step_time = delta_time;
+			if (reduced && !_is_hooked[i] && is_far(i)) {
+				step_time = (i + _num_ticks) % _far_physics_interval == 0 ? delta_time * _far_physics_interval : 0.f;
+			}
+		}
+		_step_time[i] = step_time;
+	}
+}
+
+bool sheep_store::is_far(std::size_t index) const {
+	for (const glm::vec3& p : _player_positions) {
+		const float dx = _position_x[index] - p.x;
+		const float dz = _position_z[index] - p.z;
+		if (dx*dx + dz*dz < FAR_PHYSICS_DISTANCE*FAR_PHYSICS_DISTANCE) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void sheep_store::apply_gravity() {
+	const std::size_t n = size();
+	const std::uint8_t* is_hooked = _is_hooked.data();
+	const float* step_time = _step_time.data();
+	float* speed_y = _speed_y.data();
+
+	// sleeping sheep stand on the ground, their step time is 0
+	for (std::size_t i = 0; i < n; i++) {
+		speed_y[i] -= (is_hooked[i] ? GRAVITY*HOOKED_GRAVITY_FACTOR : GRAVITY) * step_time[i];
+	}
+}
+
+// Same as body::apply_drag, written without branches for the math of one sheep.
+// Floating point selects are blended arithmetically, a multiplication in a branch could trap.
+// Unhooked sheep keep their vertical speed.
+// Only the awake sheep, that move in this tick, get drag, like the move and collide phases.
+// The arrays are passed as restrict parameters, there are too many of them to check for aliasing at run time.
+void apply_sheep_drag(
+	std::size_t n, const std::uint32_t* __restrict awake, const std::uint8_t* __restrict is_hooked, const float* __restrict jump_time,
+	const float* __restrict step_time, float* __restrict speed_x, float* __restrict speed_y, float* __restrict speed_z
+) {
+	for (std::size_t j = 0; j < n; j++) {
+		const std::uint32_t i = awake[j];
+		if (step_time[i] == 0.f) continue;
+
+		const float hooked = is_hooked[i];
+		const float drag = SHEEP_DRAG * step_time[i] * (1.f + (HOOKED_DRAG_FACTOR - 1.f)*hooked);
+		const float walk_speed = jump_time[i] != 0.f ? MAX_SHEEP_SPEED_JUMP : MAX_SHEEP_SPEED;
+		const float max_speed = walk_speed + (MAX_SHEEP_SPEED_HOOKED - walk_speed)*hooked;
+		const float length = std::sqrt(speed_x[i]*speed_x[i] + speed_y[i]*speed_y[i] + speed_z[i]*speed_z[i]);
+		// 0, if the drag is bigger than the speed
+		const float factor = std::max(std::min(length - drag, max_speed), 0.f) / std::max(std::max(length, drag), FLT_MIN);
+
+		speed_x[i] *= factor;
+		speed_y[i] *= 1.f + (factor - 1.f)*hooked;
+		speed_z[i] *= factor;
+	}
+}
+
+void sheep_store::apply_drag() {
+	apply_sheep_drag(_awake.size(), _awake.data(), _is_hooked.data(), _jump_time.data(), _step_time.data(), _speed_x.data(), _speed_y.data(), _speed_z.data());
+}
@@ -0,0 +1,158 @@
+#ifndef __SHEEP_STORE_CLASS__
+#define __SHEEP_STORE_CLASS__
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include "sheep.hpp"
+#include "random_generator.hpp"
+#include "physics/entity_grid.hpp"
+
+class block_container;
+class thread_pool;
+
+// every sheep thinks at least every DEFAULT_AI_INTERVAL ticks, while the server is not overloaded
+constexpr std::size_t DEFAULT_AI_INTERVAL = 4;
+
+/**
+ * Holds all sheep of a frame as structure of arrays.
+ *
+ * Gravity runs as a plain loop over the arrays, so the compiler can vectorize it. Drag runs over the awake sheep only.
+ * The per sheep decisions and the movement through the world work on one sheep at a time
+ * through a sheep view.
+ *
+ * The decisions of the sheep are spread over the ticks. Every tick the next sheep in
+ * round robin order think, at most ai budget many of them. Movement and physics run every tick.
+ *
+ * Waiting sheep, that stand still on the ground, fall asleep and are skipped by the tick.
+ * They wake up, when their wait is over, when they are hooked or accelerated,
+ * or when a block next to them changes.
+ *
+ * An entity grid over the map finds the sheep near a position or a ray. It is used
+ * for hooking, for waking up sheep and to push sheep apart, that get too close.
+ *
+ * Under load the sheep far away from all players can move at a reduced rate. They move in every
+ * n-th tick only, but by the time of all n ticks.
+ */
+class sheep_store {
+	public:
+		class iterator {
+			public:
+				iterator(const sheep_store* store, std::size_t index);
+
+				sheep operator*() const;
+				iterator& operator++();
+				bool operator!=(const iterator& other) const;
+			private:
+				const sheep_store* _store;
+				std::size_t _index;
+		};
+
+		sheep_store();
+
+		std::size_t size() const;
+		bool empty() const;
+
+		sheep add(const glm::vec3& position, float yaw);
+		sheep add(const glm::vec3& position, float yaw, const random_generator& random);
+		void clear();
+
+		sheep operator[](std::size_t index);
+		const sheep operator[](std::size_t index) const;
+
+		iterator begin() const;
+		iterator end() const;
+
+		/**
+		 * Advances all sheep by delta_time seconds. The per sheep phases run in parallel on the given pool, if there is one.
+		 */
+		void tick(const block_container& blocks, thread_pool* pool, float delta_time);
+
+		/**
+		 * Wakes up all sheep within range of the given position. Called, when a block changes.
+		 */
+		void wake_up_near(const glm::vec3& position, float range);
+
+		/**
+		 * Pushes the sheep near the given position away from it for delta_time seconds. Players push sheep this way.
+		 */
+		void push_away(const glm::vec3& position, float range, float delta_time);
+
+		/**
+		 * Returns the index of the sheep, that the ray hits within range and that is closest to
+		 * the start of the ray. Sheep further away from the start than max_distance are ignored.
+		 */
+		std::optional<std::size_t> get_colliding_sheep(const ray& r, float range, float max_distance) const;
+
+		/**
+		 * Sets the maximal number of sheep, that think in one tick.
+		 * Large flocks think less often, so the cost of the ai per tick stays bounded.
+		 */
+		void set_ai_budget(std::size_t ai_budget);
+		/**
+		 * Every sheep thinks at least every ai interval ticks, as long as the ai budget allows it.
+		 */
+		void set_ai_interval(std::size_t ai_interval);
+		/**
+		 * Sheep far away from all players move in every far physics interval-th tick only.
+		 * An interval of 1 moves all sheep every tick.
+		 */
+		void set_far_physics_interval(unsigned int far_physics_interval);
+		void set_player_positions(const std::vector<glm::vec3>& player_positions);
+		std::size_t get_num_awake() const;
+	private:
+		friend class sheep;
+
+		std::size_t get_num_thinking() const;
+		void collect_awake(float delta_time);
+		bool is_far(std::size_t index) const;
+		void apply_gravity();
+		void apply_drag();
+		void separate(std::size_t index, float delta_time);
+		void update_grid();
+		glm::vec3 get_position(std::size_t index) const;
+
+		std::vector<float> _position_x;
+		std::vector<float> _position_y;
+		std::vector<float> _position_z;
+		std::vector<float> _speed_x;
+		std::vector<float> _speed_y;
+		std::vector<float> _speed_z;
+		std::vector<float> _yaw;
+		// the direction of a sheep, cached until its yaw changes
+		std::vector<float> _direction_x;
+		std::vector<float> _direction_z;
+
+		std::vector<sheep_state> _state;
+		std::vector<float> _state_time; // seconds until the next decision
+		std::vector<float> _forward;
+		std::vector<float> _turn;
+		std::vector<float> _jump_time; // seconds left of the current jump
+		std::vector<std::uint8_t> _is_hooked; // no vector<bool>, sheep are written from multiple threads
+		std::vector<std::uint8_t> _asleep;
+
+		std::vector<std::uint32_t> _last_think_tick;
+
+		// indices of the sheep, that are awake in the current tick
+		std::vector<std::uint32_t> _awake;
+		// the time every sheep moves in the current tick, 0 for sheep that do not move
+		std::vector<float> _step_time;
+
+		entity_grid _grid;
+
+		// the time since the last decision of a sheep is counted in ticks, a float clock loses precision in long matches
+		std::uint32_t _num_ticks;
+		std::size_t _ai_cursor;
+		std::size_t _ai_budget;
+		std::size_t _ai_interval;
+		unsigned int _far_physics_interval;
+		std::vector<glm::vec3> _player_positions;
+
+		// every sheep has its own generator, so sheep can be ticked in any order
+		std::vector<random_generator> _random;
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+// every thread takes about this many batches of a loop, to balance uneven work
+constexpr std::size_t BATCHES_PER_THREAD = 4;
+
+thread_pool::job::job(std::size_t n, std::size_t batch_size, const std::function<void(std::size_t)>& f)
+	: f(f), n(n), batch_size(batch_size), next_index(0), num_done(0)
+{}
+
+thread_pool::thread_pool(unsigned int num_threads) : _stop(false) {
+	if (num_threads == 0) {
+		num_threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	for (unsigned int i = 1; i < num_threads; i++) {
+		_workers.push_back(std::thread(&thread_pool::worker_loop, this));
+	}
+}
+
+thread_pool::~thread_pool() {
+	{
+		std::lock_guard<std::mutex> lock(_jobs_mutex);
+		_stop = true;
+	}
+	_jobs_condition.notify_all();
+	for (std::thread& t : _workers) {
+		t.join();
+	}
+}
+
+unsigned int thread_pool::get_num_threads() const {
+	return _workers.size() + 1;
+}
+
+void thread_pool::parallel_for(std::size_t n, const std::function<void(std::size_t)>& f) {
+	if (n == 0) {
+		return;
+	}
+
+	if (_workers.empty() || n == 1) {
+		for (std::size_t i = 0; i < n; i++) {
+			f(i);
+		}
+		return;
+	}
+
+	const std::size_t batch_size = std::max<std::size_t>(1, n / (get_num_threads() * BATCHES_PER_THREAD));
+	std::shared_ptr<job> j = std::make_shared<job>(n, batch_size, f);
+
+	{
+		std::lock_guard<std::mutex> lock(_jobs_mutex);
+		_jobs.push_back(j);
+	}
+	_jobs_condition.notify_all();
+
+	work_on(j.get());
+
+	// all indices are taken, wait for the threads still working on theirs
+	while (j->num_done.load(std::memory_order_acquire) < n) {
+		std::this_thread::yield();
+	}
+}
+
+void thread_pool::worker_loop() {
+	while (true) {
+		std::shared_ptr<job> j;
+		{
+			std::unique_lock<std::mutex> lock(_jobs_mutex);
+			_jobs_condition.wait(lock, [this]() { return _stop || !_jobs.empty(); });
+			if (_stop) {
+				return;
+			}
+			j = _jobs.front();
+		}
+
+		work_on(j.get());
+	}
+}
+
+void thread_pool::work_on(job* j) {
+	while (true) {
+		const std::size_t begin = j->next_index.fetch_add(j->batch_size, std::memory_order_relaxed);
+		if (begin >= j->n) {
+			break;
+		}
+		const std::size_t end = std::min(begin + j->batch_size, j->n);
+		for (std::size_t i = begin; i < end; i++) {
+			j->f(i);
+		}
+		j->num_done.fetch_add(end - begin, std::memory_order_release);
+	}
+
+	// the job has no indices left, so no other thread should pick it up
+	std::lock_guard<std::mutex> lock(_jobs_mutex);
+	auto it = std::find_if(_jobs.begin(), _jobs.end(), [j](const std::shared_ptr<job>& other) { return other.get() == j; });
+	if (it != _jobs.end()) {
+		_jobs.erase(it);
+	}
+}
@@ -0,0 +1,57 @@
+#ifndef __THREAD_POOL_CLASS__
+#define __THREAD_POOL_CLASS__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of worker threads, that execute parallel loops.
+ * The calling thread takes part in its own loops, so parallel_for can be nested.
+ */
+class thread_pool {
+	public:
+		/**
+		 * @param num_threads The number of threads working on a loop including the caller.
+		 *                    0 uses one thread per hardware thread.
+		 */
+		explicit thread_pool(unsigned int num_threads = 0);
+		~thread_pool();
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+
+		unsigned int get_num_threads() const;
+
+		/**
+		 * Calls f(i) for every i in [0, n) and returns after all calls finished.
+		 * The indices are handed out in batches to the threads, that are idle first.
+		 */
+		void parallel_for(std::size_t n, const std::function<void(std::size_t)>& f);
+	private:
+		struct job {
+			job(std::size_t n, std::size_t batch_size, const std::function<void(std::size_t)>& f);
+
+			const std::function<void(std::size_t)>& f;
+			const std::size_t n;
+			const std::size_t batch_size;
+			std::atomic<std::size_t> next_index;
+			std::atomic<std::size_t> num_done;
+		};
+
+		void worker_loop();
+		void work_on(job* j);
+
+		std::vector<std::thread> _workers;
+		std::deque<std::shared_ptr<job>> _jobs;
+		std::mutex _jobs_mutex;
+		std::condition_variable _jobs_condition;
+		bool _stop;
+};
+
+#endif
@@ -9,6 +9,7 @@
 
 #include "../physics/forms.hpp"
 #include "../physics/util.hpp"
+#include "../random_generator.hpp"
 
 constexpr float WINNING_COLOR_WHITE = 0.3f;
 constexpr float WINNING_COLOR_BLACK = 0.03f;
@@ -138,10 +139,10 @@ glm::ivec3 block_container::to_chunk_position(const glm::ivec3& position) {
 	);
 }
 
-glm::vec3 block_container::get_respawn_position() const {
-	int x = (rand() % 5)+1;
+glm::vec3 block_container::get_respawn_position(random_generator* random) const {
+	int x = random->next(5)+1;
 	int y = 0.f;
-	int z = rand() % MAP_Z_SIZE;
+	int z = random->next(MAP_Z_SIZE);
 
 	for (int yi = -200; yi < 200; yi++) {
 		if (get_block(glm::ivec3(x, yi, z))) {
@@ -152,10 +153,10 @@ glm::vec3 block_container::get_respawn_position() const {
 	return glm::vec3(x, y+1.f, z);
 }
 
-glm::vec3 block_container::get_sheep_respawn_position() const {
-	int x = MAP_X_SIZE - ((rand() % 5)+5);
+glm::vec3 block_container::get_sheep_respawn_position(random_generator* random) const {
+	int x = MAP_X_SIZE - (random->next(5)+5);
 	int y = 0.f;
-	int z = rand() % MAP_Z_SIZE;
+	int z = random->next(MAP_Z_SIZE);
 
 	for (int yi = -200; yi < 200; yi++) {
 		if (get_block(glm::ivec3(x, yi, z))) {
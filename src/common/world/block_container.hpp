@@ -11,6 +11,7 @@
 
 class cuboid;
 class ray;
+class random_generator;
 
 constexpr unsigned int BLOCK_CHUNK_SIZE = 32;
 constexpr unsigned int MAP_X_SIZE = 128;
@@ -53,8 +54,8 @@ class block_container {
 		static glm::vec3 get_color(const glm::ivec3& position);
 		static glm::vec3 get_winning_color(const glm::ivec3& position);
 
-		glm::vec3 get_respawn_position() const;
-		glm::vec3 get_sheep_respawn_position() const;
+		glm::vec3 get_respawn_position(random_generator* random) const;
+		glm::vec3 get_sheep_respawn_position(random_generator* random) const;
 
 		std::optional<world_block> get_block(const glm::ivec3& position) const;
 		const chunk_map_type& get_chunks() const;
@@ -0,0 +1,55 @@
+#include "overload_governor.hpp"
+
+#include "../common/sheep_store.hpp"
+
+// level 0 is the undegraded simulation
+const overload_governor::settings LEVELS[] = {
+	{DEFAULT_AI_INTERVAL, 1, 1},
+	{8, 1, 1},
+	{8, 2, 1},
+	{16, 4, 1},
+	{16, 4, 2},
+};
+constexpr unsigned int NUM_LEVELS = sizeof(LEVELS) / sizeof(LEVELS[0]);
+
+// weight of the newest tick in the moving average of the load
+constexpr float LOAD_SMOOTHING = 0.05f;
+constexpr float HIGH_LOAD = 0.8f;
+constexpr float LOW_LOAD = 0.4f;
+// a level has to hold for this many ticks, so the average can show its effect before the next change
+constexpr unsigned int TICKS_BEFORE_RAISE = 30;
+constexpr unsigned int TICKS_BEFORE_LOWER = 300;
+
+overload_governor::overload_governor(std::chrono::steady_clock::duration budget)
+	: _budget(budget), _load(0.f), _level(0), _ticks_at_level(0)
+{}
+
+bool overload_governor::record_tick(std::chrono::steady_clock::duration tick_duration) {
+	const float load = std::chrono::duration<float>(tick_duration) / std::chrono::duration<float>(_budget);
+	_load += (load - _load) * LOAD_SMOOTHING;
+	_ticks_at_level++;
+
+	if (_load > HIGH_LOAD && _ticks_at_level >= TICKS_BEFORE_RAISE && _level + 1 < NUM_LEVELS) {
+		_level++;
+		_ticks_at_level = 0;
+		return true;
+	}
+	if (_load < LOW_LOAD && _ticks_at_level >= TICKS_BEFORE_LOWER && _level > 0) {
+		_level--;
+		_ticks_at_level = 0;
+		return true;
+	}
+	return false;
+}
+
+unsigned int overload_governor::get_level() const {
+	return _level;
+}
+
+const overload_governor::settings& overload_governor::get_settings() const {
+	return LEVELS[_level];
+}
+
+float overload_governor::get_load() const {
+	return _load;
+}
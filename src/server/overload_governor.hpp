@@ -0,0 +1,43 @@
+#ifndef __OVERLOAD_GOVERNOR_CLASS__
+#define __OVERLOAD_GOVERNOR_CLASS__
+
+#include <chrono>
+#include <cstddef>
+
+/**
+ * Compares the duration of the ticks with their budget and degrades the simulation,
+ * when the server can not keep up.
+ *
+ * Every overload level lowers the ai frequency of the sheep further, lets the sheep far away
+ * from all players move at a reduced rate and finally lowers the snapshot rate.
+ * When there is enough headroom again, the levels are restored one after the other.
+ */
+class overload_governor {
+	public:
+		struct settings {
+			std::size_t ai_interval;
+			unsigned int far_physics_interval;
+			unsigned int snapshot_interval; // only every n-th snapshot is published
+		};
+
+		overload_governor(std::chrono::steady_clock::duration budget);
+
+		/**
+		 * Records the duration of one tick. Returns true, if the overload level changed.
+		 */
+		bool record_tick(std::chrono::steady_clock::duration tick_duration);
+
+		unsigned int get_level() const;
+		const settings& get_settings() const;
+		/**
+		 * The smoothed ratio of tick duration and budget.
+		 */
+		float get_load() const;
+	private:
+		const std::chrono::steady_clock::duration _budget;
+		float _load;
+		unsigned int _level;
+		unsigned int _ticks_at_level;
+};
+
+#endif
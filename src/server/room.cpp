@@ -0,0 +1,127 @@
+#include "room.hpp"
+
+#include <iostream>
+
+constexpr std::size_t PEER_EVENT_QUEUE_CAPACITY = 256;
+constexpr unsigned int NUM_SHEEP = 40;
+
+room::room(unsigned int id, unsigned int map_seed, thread_pool* pool)
+	: _id(id),
+	  _map_seed(map_seed),
+	  _next_player_id(0),
+	  _num_players(0),
+	  _player_id_used{},
+	  _peer_events(PEER_EVENT_QUEUE_CAPACITY),
+	  _game_update_sequence(0)
+{
+	_current_frame.init(_map_seed, NUM_SHEEP);
+	_current_frame.set_thread_pool(pool);
+}
+
+unsigned int room::get_id() const {
+	return _id;
+}
+
+unsigned int room::get_map_seed() const {
+	return _map_seed;
+}
+
+std::optional<char> room::add_player(const std::string& name, const std::shared_ptr<input_queue>& inputs) {
+	// ids are handed out round robin, so a new player does not get the id of a player, that just left
+	unsigned int id = _next_player_id;
+	while (_player_id_used[id]) {
+		id = (id + 1) % MAX_PLAYER_IDS;
+		if (id == _next_player_id) {
+			std::cerr << "no free player id in room " << _id << ", dropping login of \"" << name << "\"" << std::endl;
+			return {};
+		}
+	}
+
+	const char player_id = id;
+	if (!_peer_events.push(peer_event{peer_event::event_type::LOGIN, player_id, name, inputs})) {
+		std::cerr << "peer event queue of room " << _id << " is full, dropping login of \"" << name << "\"" << std::endl;
+		return {};
+	}
+	_player_id_used[id] = true;
+	_next_player_id = (id + 1) % MAX_PLAYER_IDS;
+	_num_players++;
+	return player_id;
+}
+
+void room::remove_player(char player_id) {
+	if (!_peer_events.push(peer_event{peer_event::event_type::LOGOUT, player_id, "", nullptr})) {
+		std::cerr << "peer event queue of room " << _id << " is full, dropping logout of player " << (int)player_id << std::endl;
+		return;
+	}
+	_player_id_used[static_cast<unsigned char>(player_id)] = false;
+	_num_players--;
+}
+
+unsigned int room::get_num_players() const {
+	return _num_players;
+}
+
+void room::tick(float delta_time) {
+	handle_peer_events();
+	// nobody sees an empty room, so it is not simulated until a player joins
+	if (_current_frame.players.empty()) return;
+	apply_inputs();
+	_current_frame.tick(delta_time);
+}
+
+void room::set_sheep_rates(std::size_t ai_interval, unsigned int far_physics_interval) {
+	_current_frame.sheeps.set_ai_interval(ai_interval);
+	_current_frame.sheeps.set_far_physics_interval(far_physics_interval);
+}
+
+void room::handle_peer_events() {
+	while (std::optional<peer_event> event = _peer_events.pop()) {
+		switch (event->type) {
+			case peer_event::event_type::LOGIN:
+				_current_frame.add_player(event->player_id, event->player_name);
+				_player_inputs[static_cast<unsigned char>(event->player_id)] = event->inputs;
+				break;
+			case peer_event::event_type::LOGOUT:
+				if (const player* p = _current_frame.get_player(event->player_id)) {
+					std::cout << "player \"" << p->get_name() << "\" left room " << _id << std::endl;
+					_current_frame.players.erase(event->player_id);
+				}
+				_player_inputs[static_cast<unsigned char>(event->player_id)].reset();
+				break;
+		}
+	}
+}
+
+void room::apply_inputs() {
+	for (player& p : _current_frame.players) {
+		const std::shared_ptr<input_queue>& inputs = _player_inputs[static_cast<unsigned char>(p.get_id())];
+		if (!inputs) continue;
+		while (std::optional<actions_packet> packet = inputs->pop()) {
+			for (const actions_packet::input_frame& f : packet->frames) {
+				p.set_actions(f.actions);
+				p.update_direction(f.mouse_changes);
+			}
+		}
+	}
+}
+
+void room::publish_game_update() {
+	if (_current_frame.players.empty()) return;
+
+	std::shared_ptr<const game_update_packet> gup = std::make_shared<const game_update_packet>(
+		game_update_packet::from_game(_current_frame.players, _current_frame.sheeps, _current_frame.block_removes, _current_frame.block_additions)
+	);
+	std::atomic_store(&_game_update, gup);
+	_game_update_sequence++;
+
+	_current_frame.block_removes.clear();
+	_current_frame.block_additions.clear();
+}
+
+std::shared_ptr<const game_update_packet> room::get_game_update() const {
+	return std::atomic_load(&_game_update);
+}
+
+std::uint64_t room::get_game_update_sequence() const {
+	return _game_update_sequence;
+}
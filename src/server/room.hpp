@@ -0,0 +1,92 @@
+#ifndef __ROOM_CLASS__
+#define __ROOM_CLASS__
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "../common/frame.hpp"
+#include "../common/networking/actions_packet.hpp"
+#include "../common/networking/game_update_packet.hpp"
+#include "spsc_queue.hpp"
+
+class thread_pool;
+
+/**
+ * A room is one match with its own map, sheep and players.
+ *
+ * Players are added and removed by the receive thread. The room is ticked by
+ * exactly one thread per tick. At the snapshot rate the tick thread publishes a game update
+ * snapshot, which is read by the send thread. A room without players is neither simulated nor published.
+ */
+class room {
+	public:
+		using input_queue = spsc_queue<actions_packet>;
+
+		room(unsigned int id, unsigned int map_seed, thread_pool* pool);
+
+		room(const room&) = delete;
+		room& operator=(const room&) = delete;
+
+		unsigned int get_id() const;
+		unsigned int get_map_seed() const;
+
+		// receive thread
+		std::optional<char> add_player(const std::string& name, const std::shared_ptr<input_queue>& inputs);
+		void remove_player(char player_id);
+		unsigned int get_num_players() const;
+
+		// tick thread
+		void tick(float delta_time);
+		/**
+		 * Lowers the rates of the sheep ai and of the sheep far away from all players under load.
+		 */
+		void set_sheep_rates(std::size_t ai_interval, unsigned int far_physics_interval);
+		/**
+		 * Publishes a snapshot of the current frame. The blocks changed since the last
+		 * snapshot are part of it. Nothing is published while the room is empty.
+		 */
+		void publish_game_update();
+
+		// send thread
+		std::shared_ptr<const game_update_packet> get_game_update() const;
+		std::uint64_t get_game_update_sequence() const;
+	private:
+		// logins and logouts, passed from the receive thread to the tick thread
+		struct peer_event {
+			enum class event_type {
+				LOGIN,
+				LOGOUT
+			};
+
+			event_type type;
+			char player_id;
+			std::string player_name;
+			std::shared_ptr<input_queue> inputs;
+		};
+
+		void handle_peer_events();
+		void apply_inputs();
+
+		const unsigned int _id;
+		const unsigned int _map_seed;
+
+		// only used by the receive thread
+		unsigned int _next_player_id;
+		unsigned int _num_players;
+		// ids are not reused while their player is in the room
+		std::array<bool, MAX_PLAYER_IDS> _player_id_used;
+
+		spsc_queue<peer_event> _peer_events;
+
+		frame _current_frame;
+		// indexed by player id
+		std::array<std::shared_ptr<input_queue>, MAX_PLAYER_IDS> _player_inputs;
+
+		std::shared_ptr<const game_update_packet> _game_update;
+		std::atomic<std::uint64_t> _game_update_sequence;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#include "room_manager.hpp"
+
+#include <stdlib.h>
+#include <iostream>
+
+#include "../common/sheep_store.hpp"
+
+constexpr unsigned int MAX_PLAYERS_PER_ROOM = 8;
+
+room_manager::room_manager() : _next_room_id(0), _ai_interval(DEFAULT_AI_INTERVAL), _far_physics_interval(1) {}
+
+room* room_manager::find_lobby_room() {
+	for (room* r : get_rooms()) {
+		if (r->get_num_players() < MAX_PLAYERS_PER_ROOM) {
+			return r;
+		}
+	}
+	return create_room();
+}
+
+void room_manager::tick(float delta_time) {
+	std::vector<room*> rooms = get_rooms();
+	_pool.parallel_for(rooms.size(), [this, &rooms, delta_time](std::size_t i) {
+		rooms[i]->set_sheep_rates(_ai_interval, _far_physics_interval);
+		rooms[i]->tick(delta_time);
+	});
+}
+
+void room_manager::publish_game_updates() {
+	std::vector<room*> rooms = get_rooms();
+	_pool.parallel_for(rooms.size(), [&rooms](std::size_t i) {
+		rooms[i]->publish_game_update();
+	});
+}
+
+void room_manager::set_sheep_rates(std::size_t ai_interval, unsigned int far_physics_interval) {
+	_ai_interval = ai_interval;
+	_far_physics_interval = far_physics_interval;
+}
+
+std::vector<room*> room_manager::get_rooms() {
+	std::lock_guard<std::mutex> lock(_rooms_mutex);
+	std::vector<room*> rooms;
+	for (const std::unique_ptr<room>& r : _rooms) {
+		rooms.push_back(r.get());
+	}
+	return rooms;
+}
+
+room* room_manager::create_room() {
+	// the map is created outside of the lock, so ticking other rooms is not blocked
+	std::unique_ptr<room> new_room = std::make_unique<room>(_next_room_id, rand(), &_pool);
+	_next_room_id++;
+	room* r = new_room.get();
+
+	std::lock_guard<std::mutex> lock(_rooms_mutex);
+	_rooms.push_back(std::move(new_room));
+	std::cout << "created room " << r->get_id() << std::endl;
+	return r;
+}
@@ -0,0 +1,57 @@
+#ifndef __ROOM_MANAGER_CLASS__
+#define __ROOM_MANAGER_CLASS__
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../common/thread_pool.hpp"
+#include "room.hpp"
+
+/**
+ * Owns all rooms of the server and ticks them in parallel on a thread pool.
+ * The rooms use the same pool to tick their sheep.
+ */
+class room_manager {
+	public:
+		room_manager();
+
+		/**
+		 * The lobby policy: returns the room a new player should join.
+		 * Fills the existing rooms in order and creates a new room, if all of them are full.
+		 * Called by the receive thread.
+		 */
+		room* find_lobby_room();
+
+		/**
+		 * Creates an empty room, used when a player cannot join the lobby room.
+		 * Called by the receive thread.
+		 */
+		room* create_room();
+
+		/**
+		 * Ticks every room exactly once by delta_time seconds. Every room is ticked by one thread.
+		 */
+		void tick(float delta_time);
+
+		/**
+		 * Publishes a game update snapshot of every room.
+		 */
+		void publish_game_updates();
+
+		/**
+		 * The sheep rates are applied to every room before its next tick, including rooms created later.
+		 */
+		void set_sheep_rates(std::size_t ai_interval, unsigned int far_physics_interval);
+
+		std::vector<room*> get_rooms();
+	private:
+		std::vector<std::unique_ptr<room>> _rooms;
+		std::mutex _rooms_mutex;
+		unsigned int _next_room_id;
+		std::size_t _ai_interval;
+		unsigned int _far_physics_interval;
+		thread_pool _pool;
+};
+
+#endif
@@ -2,36 +2,135 @@
 
 #include <stdlib.h>
 #include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
 
 #include "../common/networking/login_packet.hpp"
-#include "../common/networking/actions_packet.hpp"
-#include "../common/networking/game_update_packet.hpp"
 #include "../common/networking/packet_ids.hpp"
 #include "../common/networking/init_packet.hpp"
 #include <netsi/util/cycle.hpp>
 
-server::server() : _server_network_manager(1350, BUFFER_SIZE), _next_player_id(0) {}
+constexpr unsigned int DEFAULT_SIMULATION_RATE = 60;
+constexpr unsigned int DEFAULT_SNAPSHOT_RATE = 25;
+// a tick thread, that fell behind, runs at most this many ticks at once and drops the rest
+constexpr unsigned int MAX_CATCH_UP_TICKS = 4;
+constexpr unsigned int RECEIVE_CYCLE_MILLISECONDS = 2;
+constexpr std::size_t INPUT_QUEUE_CAPACITY = 64;
+// room updates of a few snapshots, in case the receive thread is late
+constexpr std::size_t ROOM_UPDATE_QUEUE_CAPACITY = 256;
+
+// set by the signal handler, the tick thread stops the server, when it sees it
+std::atomic<bool> stop_requested(false);
+
+void request_stop(int) {
+	stop_requested = true;
+}
+
+std::chrono::steady_clock::duration rate_to_duration(unsigned int rate) {
+	return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / rate));
+}
+
+server::server(unsigned int simulation_rate, unsigned int snapshot_rate)
+	: _server_network_manager(1350, BUFFER_SIZE),
+	  _room_updates(ROOM_UPDATE_QUEUE_CAPACITY),
+	  _tick_duration(rate_to_duration(simulation_rate)),
+	  _snapshot_duration(rate_to_duration(snapshot_rate)),
+	  _overload_governor(_tick_duration),
+	  _snapshot_sequence(0),
+	  _running(false)
+{}
 
 void server::init() {
 	srand(time(NULL));
-	_map_seed = rand();
-	_current_frame.blocks = block_container(block_container::create_field(_map_seed));
-	for (unsigned int i = 0; i < 40; i++) {
-		_current_frame.sheeps.push_back(sheep(_current_frame.blocks.get_sheep_respawn_position(), 0.f));
-	}
+
+	// create the first room up front, so the first login does not wait for the map
+	_room_manager.find_lobby_room();
 }
 
 void server::run() {
 	std::cout << "server is running on port 1350" << std::endl;
 
-	for (netsi::Cycle c(_server_network_manager.get_context(), boost::posix_time::milliseconds(40));; c.next()) {
+	_running = true;
+	_receive_thread = std::thread(&server::receive_loop, this);
+	_send_thread = std::thread(&server::send_loop, this);
+
+	tick_loop();
+
+	_running = false;
+	_snapshot_condition.notify_all();
+	_receive_thread.join();
+	_send_thread.join();
+
+	std::cout << "server is offline" << std::endl;
+}
+
+// ------- TICK THREAD -------
+
+// The elapsed time is accumulated and consumed in ticks of fixed length. Snapshots are
+// published on their own schedule, after the ticks that were due.
+// The overload governor measures every tick and degrades the simulation, when the ticks overrun.
+void server::tick_loop() {
+	const float delta_time = std::chrono::duration<float>(_tick_duration).count();
+
+	std::chrono::steady_clock::duration accumulator(0);
+	auto last_time = std::chrono::steady_clock::now();
+	auto next_snapshot = last_time;
+	while (!stop_requested) {
+		const auto now = std::chrono::steady_clock::now();
+		accumulator += now - last_time;
+		last_time = now;
+
+		unsigned int num_ticks = 0;
+		while (accumulator >= _tick_duration && num_ticks < MAX_CATCH_UP_TICKS) {
+			const auto tick_start = std::chrono::steady_clock::now();
+			_room_manager.tick(delta_time);
+			if (_overload_governor.record_tick(std::chrono::steady_clock::now() - tick_start)) {
+				const overload_governor::settings& s = _overload_governor.get_settings();
+				_room_manager.set_sheep_rates(s.ai_interval, s.far_physics_interval);
+				report_overload();
+			}
+			accumulator -= _tick_duration;
+			num_ticks++;
+		}
+		if (accumulator >= _tick_duration) {
+			// the simulation slows down instead of bursting
+			accumulator = std::chrono::steady_clock::duration(0);
+		}
+
+		if (now >= next_snapshot) {
+			_room_manager.publish_game_updates();
+			_snapshot_sequence++;
+			_snapshot_condition.notify_one();
+
+			next_snapshot += _snapshot_duration * _overload_governor.get_settings().snapshot_interval;
+			if (next_snapshot < now) {
+				next_snapshot = now + _snapshot_duration;
+			}
+		}
+
+		const auto next_tick = last_time + (_tick_duration - accumulator);
+		std::this_thread::sleep_until(std::min(next_tick, next_snapshot));
+	}
+}
+
+void server::report_overload() const {
+	const overload_governor::settings& s = _overload_governor.get_settings();
+	std::cout << "overload level " << _overload_governor.get_level()
+			  << " (load " << _overload_governor.get_load() << ")"
+			  << ": ai interval " << s.ai_interval
+			  << ", far physics interval " << s.far_physics_interval
+			  << ", snapshot interval " << s.snapshot_interval << std::endl;
+}
+
+// ------- RECEIVE THREAD -------
+
+void server::receive_loop() {
+	for (netsi::Cycle c(_server_network_manager.get_context(), boost::posix_time::milliseconds(RECEIVE_CYCLE_MILLISECONDS)); _running; c.next()) {
 		check_new_peers();
 		handle_clients();
-		_current_frame.tick();
-		send_game_update();
+		send_room_updates();
 	}
-
-	std::cout << "server is offline" << std::endl;
 }
 
 void server::check_new_peers() {
@@ -39,40 +138,74 @@ void server::check_new_peers() {
 		netsi::ClientRequest client_request = _server_network_manager.pop_client_request();
 		netsi::Peer remote_peer = _server_network_manager.create_peer(client_request.endpoint);
 		server::peer_wrapper new_peer_wrapper(remote_peer, -1);
-		handle_login(client_request.message, &new_peer_wrapper);
-		_peers.push_back(new_peer_wrapper);
+		// a peer without a room would wait for its init packet forever, so it is not registered
+		if (handle_login(client_request.message, &new_peer_wrapper)) {
+			_peers.push_back(new_peer_wrapper);
+		}
 	}
 }
 
-void server::handle_login(const std::vector<char>& login_message, server::peer_wrapper* peer_wrapper) {
+bool server::handle_login(const std::vector<char>& login_message, server::peer_wrapper* peer_wrapper) {
 	login_packet p = login_packet::from_message(login_message);
-	_current_frame.players.push_back(player(_next_player_id, p.get_player_name(), _current_frame.blocks.get_respawn_position()));
-	peer_wrapper->player_id = _next_player_id;
 
-	send_init(_next_player_id, peer_wrapper);
+	room* lobby_room = _room_manager.find_lobby_room();
+	std::shared_ptr<room::input_queue> inputs = std::make_shared<room::input_queue>(INPUT_QUEUE_CAPACITY);
+	std::optional<char> player_id = lobby_room->add_player(p.get_player_name(), inputs);
+	if (!player_id) {
+		// the lobby room has no free player id or its peer event queue is full, a new room has neither problem
+		lobby_room = _room_manager.create_room();
+		player_id = lobby_room->add_player(p.get_player_name(), inputs);
+		if (!player_id) {
+			std::cerr << "login of \"" << p.get_player_name() << "\" failed" << std::endl;
+			return false;
+		}
+	}
+
+	peer_wrapper->player_id = *player_id;
+	peer_wrapper->inputs = inputs;
+	peer_wrapper->peer_room = lobby_room;
+	peer_wrapper->last_input_sequence = 0;
 
-	_next_player_id++;
-	std::cout << "new player \"" << p.get_player_name() << "\"" << std::endl;
+	send_init(peer_wrapper);
+
+	std::cout << "new player \"" << p.get_player_name() << "\" in room " << lobby_room->get_id() << std::endl;
+	return true;
 }
 
 void server::handle_logout(server::peer_wrapper* peer_wrapper) {
 	// peer_wrapper->peer.disconnect(); TODO
 	peer_wrapper->disconnected = true;
 
-	for (auto it = _current_frame.players.begin(); it != _current_frame.players.end(); ++it) {
-		if (it->get_id() == peer_wrapper->player_id) {
-			std::cout << "player \"" << it->get_name() << "\" disconnected" << std::endl;
-			it = _current_frame.players.erase(it);
-			break;
-		}
+	if (peer_wrapper->peer_room) {
+		peer_wrapper->peer_room->remove_player(peer_wrapper->player_id);
 	}
 }
 
 void server::handle_actions(const std::vector<char>& message, peer_wrapper* peer_wrapper) {
-	actions_packet packet = actions_packet::from_message(message);
-	player* current_player = _current_frame.get_player(peer_wrapper->player_id);
-	current_player->set_actions(packet.actions);
-	current_player->update_direction(packet.mouse_changes);
+	std::optional<actions_packet> received = actions_packet::from_message(message);
+	if (!received) {
+		return;
+	}
+	const actions_packet& packet = *received;
+
+	// frames are repeated in following packets, only pass the ones we did not see yet
+	actions_packet new_frames;
+	new_frames.sequence = packet.sequence;
+	for (std::size_t i = 0; i < packet.frames.size(); i++) {
+		if (packet.get_frame_sequence(i) > peer_wrapper->last_input_sequence) {
+			new_frames.frames.push_back(packet.frames[i]);
+		}
+	}
+
+	if (new_frames.frames.empty() || !peer_wrapper->inputs) {
+		return;
+	}
+
+	if (!peer_wrapper->inputs->push(new_frames)) {
+		std::cerr << "input queue of player " << (int)(peer_wrapper->player_id) << " is full" << std::endl;
+		return;
+	}
+	peer_wrapper->last_input_sequence = packet.sequence;
 }
 
 void server::handle_message(const std::vector<char>& message, server::peer_wrapper* peer_wrapper) {
@@ -103,30 +236,87 @@ void server::handle_clients() {
 	_peers.erase(std::remove_if(_peers.begin(), _peers.end(), [](const server::peer_wrapper& p) { return p.disconnected; }), _peers.end());
 }
 
-void server::send_game_update() {
-	game_update_packet gup = game_update_packet::from_game(_current_frame.players, _current_frame.sheeps, _current_frame.block_removes, _current_frame.block_additions);
-	for (server::peer_wrapper& p : _peers) {
-		std::vector<char> buffer;
-		gup.write_to(&buffer);
-		if (buffer.size() > BUFFER_SIZE) {
-			std::cerr << "game update buffer size exceeded.\n\tpacketsize=" << buffer.size() << "\n\tbuffersize=" << BUFFER_SIZE << std::endl;
-		} else {
-			p.peer.send(buffer);
+void server::send_init(peer_wrapper* pw) const {
+	init_packet packet(pw->player_id, pw->peer_room->get_map_seed());
+	std::vector<char> buffer;
+	packet.write_to(&buffer);
+	pw->peer.send(buffer);
+}
+
+void server::send_room_updates() {
+	while (std::optional<room_update> update = _room_updates.pop()) {
+		for (server::peer_wrapper& p : _peers) {
+			if (p.peer_room == update->update_room) {
+				p.peer.send(update->buffer);
+			}
 		}
 	}
-	_current_frame.block_removes.clear();
-	_current_frame.block_additions.clear();
 }
 
-void server::send_init(char player_id, peer_wrapper* pw) const {
-	init_packet packet(player_id, _map_seed);
-	std::vector<char> buffer;
-	packet.write_to(&buffer);
-	pw->peer.send(buffer);
+// ------- SEND THREAD -------
+
+void server::send_loop() {
+	std::uint64_t last_snapshot_sequence = 0;
+	std::unordered_map<const room*, std::uint64_t> sent_sequences;
+	while (_running) {
+		{
+			// the tick thread notifies without locking, so wake up regularly to not miss a snapshot
+			std::unique_lock<std::mutex> lock(_snapshot_mutex);
+			_snapshot_condition.wait_for(lock, _snapshot_duration / 4, [this, last_snapshot_sequence]() {
+				return _snapshot_sequence != last_snapshot_sequence || !_running;
+			});
+		}
+
+		const std::uint64_t snapshot_sequence = _snapshot_sequence;
+		if (snapshot_sequence == last_snapshot_sequence) {
+			continue;
+		}
+		last_snapshot_sequence = snapshot_sequence;
+
+		serialize_game_updates(&sent_sequences);
+	}
+}
+
+void server::serialize_game_updates(std::unordered_map<const room*, std::uint64_t>* sent_sequences) {
+	// serialize the snapshot of every room with a new game update once, the receive thread sends it
+	for (const room* r : _room_manager.get_rooms()) {
+		const std::uint64_t sequence = r->get_game_update_sequence();
+		if (sequence == (*sent_sequences)[r]) {
+			continue;
+		}
+		(*sent_sequences)[r] = sequence;
+
+		room_update update{r, {}};
+		r->get_game_update()->write_to(&update.buffer);
+		if (update.buffer.size() > BUFFER_SIZE) {
+			std::cerr << "game update buffer size exceeded in room " << r->get_id() << ".\n\tpacketsize=" << update.buffer.size() << "\n\tbuffersize=" << BUFFER_SIZE << std::endl;
+			continue;
+		}
+		if (!_room_updates.push(update)) {
+			std::cerr << "room update queue is full, dropping game update of room " << r->get_id() << std::endl;
+		}
+	}
 }
 
-int main() {
-	server svr;
+// usage: server [simulation rate] [snapshot rate]
+int main(int argc, char** argv) {
+	unsigned int simulation_rate = DEFAULT_SIMULATION_RATE;
+	unsigned int snapshot_rate = DEFAULT_SNAPSHOT_RATE;
+	if (argc > 1) {
+		simulation_rate = atoi(argv[1]);
+	}
+	if (argc > 2) {
+		snapshot_rate = atoi(argv[2]);
+	}
+	if (simulation_rate == 0 || snapshot_rate == 0) {
+		std::cerr << "usage: " << argv[0] << " [simulation rate] [snapshot rate]" << std::endl;
+		return 1;
+	}
+
+	std::signal(SIGINT, request_stop);
+	std::signal(SIGTERM, request_stop);
+
+	server svr(simulation_rate, snapshot_rate);
 	svr.init();
 	svr.run();
 
@@ -1,42 +1,100 @@
 #ifndef __SERVER_CLASS__
 #define __SERVER_CLASS__
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
 #include <netsi/server.hpp>
 
-#include "../common/frame.hpp"
 #include "../common/networking/buffer_size.hpp"
+#include "overload_governor.hpp"
+#include "room_manager.hpp"
+#include "spsc_queue.hpp"
 
+/**
+ * The server runs on three threads:
+ *   - the receive thread owns the netsi io context and does all socket io: it decodes messages,
+ *     pushes actions into per peer queues and sends the game updates serialized by the send thread
+ *   - the tick thread ticks all rooms on the thread pool of the room manager with a fixed timestep
+ *     and publishes a snapshot of every room at the snapshot rate
+ *   - the send thread serializes the latest snapshot of every room and passes it to the receive thread
+ *
+ * The server stops after SIGINT or SIGTERM.
+ *
+ * The simulation rate and the snapshot rate are independent, so the feel of the game
+ * and the bandwidth can be tuned separately.
+ */
 class server {
 	public:
-		server();
+		/**
+		 * The rates are given in hertz.
+		 */
+		server(unsigned int simulation_rate, unsigned int snapshot_rate);
 
 		void init();
 		void run();
 	private:
+		// a serialized game update of a room, passed from the send thread to the receive thread
+		struct room_update {
+			const room* update_room;
+			std::vector<char> buffer;
+		};
+
 		struct peer_wrapper {
-			peer_wrapper(const netsi::Peer& peer, const int player_id) : peer(peer), player_id(player_id), disconnected(false) {}
+			peer_wrapper(const netsi::Peer& peer, const int player_id) : peer(peer), player_id(player_id), disconnected(false), last_input_sequence(0), peer_room(nullptr) {}
 
 			netsi::Peer peer;
 			char player_id;
 			bool disconnected;
+			std::uint32_t last_input_sequence;
+			std::shared_ptr<room::input_queue> inputs;
+			room* peer_room;
 		};
 
+		// receive thread
+		void receive_loop();
 		void check_new_peers();
 		void handle_clients();
 		void handle_message(const std::vector<char>& message, peer_wrapper*);
-		void handle_login(const std::vector<char>& login_message, peer_wrapper*);
+		/**
+		 * Adds the player to a room and sends the init packet. Returns false, if no room took the player.
+		 */
+		bool handle_login(const std::vector<char>& login_message, peer_wrapper*);
 		void handle_logout(peer_wrapper*);
 		void handle_actions(const std::vector<char>& message, peer_wrapper*);
-		void send_game_update();
-		void send_init(char player_id, peer_wrapper* pw) const;
+		void send_init(peer_wrapper* pw) const;
+		void send_room_updates();
+
+		// tick thread
+		void tick_loop();
+		void report_overload() const;
 
-		player* get_player(char player_id);
+		// send thread
+		void send_loop();
+		void serialize_game_updates(std::unordered_map<const room*, std::uint64_t>* sent_sequences);
 
 		netsi::ServerNetworkManager _server_network_manager;
-		std::vector<peer_wrapper> _peers;
-		frame _current_frame;
-		unsigned int _next_player_id;
-		unsigned int _map_seed;
+		std::vector<peer_wrapper> _peers; // only used by the receive thread
+		spsc_queue<room_update> _room_updates;
+
+		room_manager _room_manager;
+
+		const std::chrono::steady_clock::duration _tick_duration;
+		const std::chrono::steady_clock::duration _snapshot_duration;
+		overload_governor _overload_governor; // only used by the tick thread
+
+		std::atomic<std::uint64_t> _snapshot_sequence;
+		std::mutex _snapshot_mutex;
+		std::condition_variable _snapshot_condition;
+
+		std::atomic<bool> _running;
+		std::thread _receive_thread;
+		std::thread _send_thread;
 };
 
 #endif
@@ -0,0 +1,59 @@
+#ifndef __SPSC_QUEUE_CLASS__
+#define __SPSC_QUEUE_CLASS__
+
+#include <atomic>
+#include <optional>
+#include <vector>
+
+/**
+ * A bounded lock-free queue for exactly one producer thread and one consumer thread.
+ */
+template<typename T>
+class spsc_queue {
+	public:
+		explicit spsc_queue(std::size_t capacity) : _buffer(capacity + 1), _head(0), _tail(0) {}
+
+		spsc_queue(const spsc_queue&) = delete;
+		spsc_queue& operator=(const spsc_queue&) = delete;
+
+		/**
+		 * Called by the producer thread.
+		 *
+		 * @return false, if the queue is full and t was not inserted.
+		 */
+		bool push(const T& t) {
+			const std::size_t tail = _tail.load(std::memory_order_relaxed);
+			const std::size_t next_tail = next(tail);
+			if (next_tail == _head.load(std::memory_order_acquire)) {
+				return false;
+			}
+			_buffer[tail] = t;
+			_tail.store(next_tail, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * Called by the consumer thread.
+		 */
+		std::optional<T> pop() {
+			const std::size_t head = _head.load(std::memory_order_relaxed);
+			if (head == _tail.load(std::memory_order_acquire)) {
+				return {};
+			}
+			std::optional<T> t(std::move(_buffer[head]));
+			_head.store(next(head), std::memory_order_release);
+			return t;
+		}
+	private:
+		std::size_t next(std::size_t index) const {
+			return (index + 1) % _buffer.size();
+		}
+
+		std::vector<T> _buffer;
+
+		// head and tail live on separate cache lines, as they are written by different threads
+		alignas(64) std::atomic<std::size_t> _head;
+		alignas(64) std::atomic<std::size_t> _tail;
+};
+
+#endif
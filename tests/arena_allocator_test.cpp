@@ -0,0 +1,60 @@
+#include <iostream>
+#include <string>
+
+#include <client/render/shape/arena_allocator.hpp>
+
+unsigned int num_failed = 0;
+
+void check(const std::string& name, bool value, bool expected) {
+	std::cout << name << ": " << (value == expected ? "ok" : "FAILED") << std::endl;
+	if (value != expected) {
+		num_failed++;
+	}
+}
+
+int main() {
+	arena_allocator allocator(1000);
+	const std::optional<std::size_t> a = allocator.allocate(100);
+	const std::optional<std::size_t> b = allocator.allocate(200);
+	const std::optional<std::size_t> c = allocator.allocate(300);
+	check("first allocation at 0", a == std::size_t(0), true);
+	check("allocations follow each other", b == std::size_t(100) && c == std::size_t(300), true);
+	check("used after allocating", allocator.get_used() == 600, true);
+	check("too large allocation", allocator.allocate(401).has_value(), false);
+
+	// the range of a is reused first fit, a range larger than it is not
+	allocator.free(*a, 100);
+	check("allocation larger than freed range", allocator.allocate(150) == std::size_t(600), true);
+	check("allocation reuses freed range", allocator.allocate(100) == std::size_t(0), true);
+	allocator.free(0, 100);
+	allocator.free(600, 150);
+
+	// freeing b and c merges them with the free range in front and the free space behind
+	allocator.free(*b, 200);
+	allocator.free(*c, 300);
+	check("used after freeing everything", allocator.get_used() == 0, true);
+	check("freed ranges are merged", allocator.allocate(1000) == std::size_t(0), true);
+	allocator.free(0, 1000);
+
+	// growing adds free space at the end and keeps the allocated ranges
+	const std::optional<std::size_t> d = allocator.allocate(600);
+	const std::optional<std::size_t> e = allocator.allocate(400);
+	allocator.grow(2000);
+	check("capacity after growing", allocator.get_capacity() == 2000, true);
+	check("used after growing", allocator.get_used() == 1000, true);
+	check("allocation after growing at the old end", allocator.allocate(1000) == std::size_t(1000), true);
+	allocator.free(*e, 400);
+	check("grow kept the range in front", allocator.allocate(400) == e && d == std::size_t(0), true);
+
+	check("smallest size class", arena_allocator::get_size_class(1) == 256, true);
+	check("size class 256", arena_allocator::get_size_class(256) == 256, true);
+	check("257 rounds up to 320", arena_allocator::get_size_class(257) == 320, true);
+	check("size class 320", arena_allocator::get_size_class(320) == 320, true);
+	check("size class 448", arena_allocator::get_size_class(448) == 448, true);
+	check("449 rounds up to 512", arena_allocator::get_size_class(449) == 512, true);
+	check("size class 512", arena_allocator::get_size_class(512) == 512, true);
+	check("513 rounds up to 640", arena_allocator::get_size_class(513) == 640, true);
+
+	std::cout << num_failed << " failed" << std::endl;
+	return num_failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <chrono>
+
+#include <glm/glm.hpp>
+
+#include <common/world/block_container.hpp>
+#include <client/render/shape/chunk_mesher.hpp>
+
+constexpr unsigned int MAP_SEED = 4242;
+constexpr unsigned int REPETITIONS = 5;
+constexpr unsigned int QUAD_SIZE = 4;
+
+// the area of all quads, so the merged meshes can be checked to cover the same faces
+double get_area(const std::vector<chunk_vertex>& vertices) {
+	double area = 0.0;
+	for (std::size_t i = 0; i + QUAD_SIZE <= vertices.size(); i += QUAD_SIZE) {
+		const glm::vec3 corner0 = get_chunk_vertex_position(vertices[i]);
+		const glm::vec3 corner1 = get_chunk_vertex_position(vertices[i+1]);
+		const glm::vec3 corner2 = get_chunk_vertex_position(vertices[i+2]);
+		area += glm::distance(corner0, corner1) * glm::distance(corner1, corner2);
+	}
+	return area;
+}
+
+int main() {
+	block_container blocks(block_container::create_field(MAP_SEED));
+	const std::size_t num_chunks = blocks.get_chunks().size();
+
+	double per_face_area = 0.0;
+	for (mesh_mode mode : {mesh_mode::PER_FACE, mesh_mode::GREEDY_EXACT, mesh_mode::GREEDY_TOLERANCE}) {
+		std::size_t num_vertices = 0;
+		double area = 0.0;
+
+		auto start = std::chrono::steady_clock::now();
+		for (unsigned int r = 0; r < REPETITIONS; r++) {
+			num_vertices = 0;
+			area = 0.0;
+			for (const auto& chunk : blocks.get_chunks()) {
+				const chunk_borders borders = get_chunk_borders(blocks, chunk.second->get_origin());
+				const std::vector<chunk_vertex> vertices = build_chunk_mesh(chunk.second->get_block_types(), borders, chunk.second->get_origin(), mode);
+				num_vertices += vertices.size();
+				area += get_area(vertices);
+			}
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		if (mode == mesh_mode::PER_FACE) {
+			per_face_area = area;
+		}
+
+		const char* name = mode == mesh_mode::PER_FACE ? "per face:        " : (mode == mesh_mode::GREEDY_EXACT ? "greedy exact:    " : "greedy tolerance:");
+		std::cout << name
+				  << " vertices/chunk=" << num_vertices / num_chunks
+				  << " KiB/chunk=" << num_vertices * sizeof(chunk_vertex) / (1024.0 * num_chunks)
+				  << " ms/chunk=" << std::chrono::duration<double, std::milli>(end - start).count() / (REPETITIONS * num_chunks)
+				  << (area == per_face_area ? "" : " (AREA MISMATCH)") << std::endl;
+	}
+	std::cout << num_chunks << " chunks" << std::endl;
+	return 0;
+}
@@ -0,0 +1,44 @@
+#include <iostream>
+#include <string>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <client/render/frustum.hpp>
+
+unsigned int num_failed = 0;
+
+void check(const std::string& name, bool value, bool expected) {
+	std::cout << name << ": " << (value == expected ? "ok" : "FAILED") << std::endl;
+	if (value != expected) {
+		num_failed++;
+	}
+}
+
+int main() {
+	// looking from the origin along -z, like the renderer with a 60 degree field of view
+	const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 4.f/3.f, 0.1f, 600.f);
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.f), glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, 1.f, 0.f));
+	const frustum f(projection * view);
+
+	check("box in front", f.contains_box(glm::vec3(-1.f, -1.f, -11.f), glm::vec3(1.f, 1.f, -9.f)), true);
+	check("box behind", f.contains_box(glm::vec3(-1.f, -1.f, 9.f), glm::vec3(1.f, 1.f, 11.f)), false);
+	check("box left", f.contains_box(glm::vec3(-40.f, -1.f, -11.f), glm::vec3(-30.f, 1.f, -9.f)), false);
+	check("box above", f.contains_box(glm::vec3(-1.f, 30.f, -11.f), glm::vec3(1.f, 40.f, -9.f)), false);
+	check("box beyond far plane", f.contains_box(glm::vec3(-1.f, -1.f, -700.f), glm::vec3(1.f, 1.f, -650.f)), false);
+	check("box around camera", f.contains_box(glm::vec3(-16.f), glm::vec3(16.f)), true);
+	check("box crossing left plane", f.contains_box(glm::vec3(-40.f, -1.f, -11.f), glm::vec3(-5.f, 1.f, -9.f)), true);
+
+	check("sphere in front", f.contains_sphere(glm::vec3(0.f, 0.f, -5.f), 1.f), true);
+	check("sphere behind", f.contains_sphere(glm::vec3(0.f, 0.f, 5.f), 1.f), false);
+	check("sphere behind touching near plane", f.contains_sphere(glm::vec3(0.f, 0.f, 0.5f), 1.f), true);
+	check("sphere right", f.contains_sphere(glm::vec3(30.f, 0.f, -10.f), 1.f), false);
+
+	// the chunk the camera is in is never culled, wherever the camera looks
+	const glm::mat4 turned_view = glm::lookAt(glm::vec3(100.f, 20.f, 30.f), glm::vec3(90.f, 15.f, 35.f), glm::vec3(0.f, 1.f, 0.f));
+	const frustum turned(projection * turned_view);
+	check("box containing turned camera", turned.contains_box(glm::vec3(95.5f, -0.5f, -0.5f), glm::vec3(127.5f, 31.5f, 31.5f)), true);
+
+	std::cout << num_failed << " failed" << std::endl;
+	return num_failed == 0 ? 0 : 1;
+}
@@ -3,8 +3,8 @@
 #include <common/world/world_block.hpp>
 #include <common/networking/game_update_packet.hpp>
 #include <common/networking/actions_packet.hpp>
-#include <common/player.hpp>
-#include <common/sheep.hpp>
+#include <common/player_map.hpp>
+#include <common/sheep_store.hpp>
 
 std::ostream& operator<<(std::ostream& stream, const game_update_packet::player_info& player_info) {
 	stream << "player_info(id=" << (int)(player_info.id) <<
@@ -14,17 +14,17 @@ std::ostream& operator<<(std::ostream& stream, const game_update_packet::player_
 }
 
 void test_game_update_packet() {
-	std::vector<player> players;
-	players.push_back(player(0, "peter"));
-	players.push_back(player(1, "klaus"));
-	players.push_back(player(2, "hansi"));
+	player_map players;
+	players.insert(player(0, "peter"));
+	players.insert(player(1, "klaus"));
+	players.insert(player(2, "hansi"));
 
 	for (player& p : players) {
 		p.set_position(glm::vec3(1.3f, 5.3f, 442.f));
 		p.set_view_angles(glm::vec2(1.0f, 2.1f));
 	}
 
-	game_update_packet packet = game_update_packet::from_game(players, std::vector<sheep>(), std::vector<glm::ivec3>(), std::vector<glm::ivec3>());
+	game_update_packet packet = game_update_packet::from_game(players, sheep_store(), std::vector<glm::ivec3>(), std::vector<glm::ivec3>());
 	std::vector<char> message;
 
 	packet.write_to(&message);
@@ -37,15 +37,32 @@ void test_game_update_packet() {
 }
 
 void test_actions_packet() {
-	actions_packet packet(0b011001, glm::vec2(0.42f, 0.32f));
+	std::vector<actions_packet::input_frame> frames;
+	frames.push_back(actions_packet::input_frame(0b011001, glm::vec2(0.42f, 0.32f)));
+	frames.push_back(actions_packet::input_frame(0b011001, glm::vec2()));
+	frames.push_back(actions_packet::input_frame(0b100001, glm::vec2(-1.f, 3.f)));
+	actions_packet packet(7, frames);
 
 	std::vector<char> buffer;
 	packet.write_to(&buffer);
 
-	actions_packet packet_copy = actions_packet::from_message(buffer);
+	actions_packet packet_copy = *actions_packet::from_message(buffer);
 
-	std::cout << "actions: " << packet.actions << " mouse changes: " << packet.mouse_changes.x << ", " << packet.mouse_changes.y << std::endl;
-	std::cout << "actions: " << packet_copy.actions << " mouse changes: " << packet_copy.mouse_changes.x << ", " << packet_copy.mouse_changes.y << std::endl;
+	for (unsigned int i = 0; i < packet_copy.frames.size(); i++) {
+		const actions_packet::input_frame& f = packet.frames[i];
+		const actions_packet::input_frame& f_copy = packet_copy.frames[i];
+		std::cout << "sequence: " << packet.get_frame_sequence(i) << " actions: " << f.actions << " mouse changes: " << f.mouse_changes.x << ", " << f.mouse_changes.y << std::endl;
+		std::cout << "sequence: " << packet_copy.get_frame_sequence(i) << " actions: " << f_copy.actions << " mouse changes: " << f_copy.mouse_changes.x << ", " << f_copy.mouse_changes.y << std::endl;
+	}
+
+	// every shorter prefix of the message has to be rejected
+	bool all_rejected = true;
+	for (std::size_t size = 0; size < buffer.size(); size++) {
+		if (actions_packet::from_message(std::vector<char>(buffer.begin(), buffer.begin() + size))) {
+			all_rejected = false;
+		}
+	}
+	std::cout << "truncated actions packets rejected: " << all_rejected << std::endl;
 }
 
 int main() {
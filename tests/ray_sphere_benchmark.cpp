@@ -0,0 +1,83 @@
+#include <iostream>
+#include <chrono>
+#include <optional>
+#include <vector>
+
+#define GLM_ENABLE_EXPERIMENTAL
+
+#include <glm/gtx/norm.hpp>
+
+#include <common/sheep_store.hpp>
+#include <common/random_generator.hpp>
+#include <common/physics/ray_sphere.hpp>
+
+constexpr unsigned int NUM_RAYS = 1000;
+constexpr float HOOK_RANGE = 15.f;
+
+// the loop of hook::check_target before the sheep were tested in batches
+std::optional<std::size_t> single_sheep_loop(const sheep_store& sheeps, const ray& r, float max_distance) {
+	std::optional<std::size_t> closest_index;
+	float closest_distance2 = max_distance*max_distance;
+	for (std::size_t i = 0; i < sheeps.size(); i++) {
+		const float distance2 = glm::distance2(sheeps[i].get_position(), r.position);
+		if (distance2 < closest_distance2 && sheeps[i].is_colliding(r, max_distance)) {
+			closest_index = i;
+			closest_distance2 = distance2;
+		}
+	}
+	return closest_index;
+}
+
+float random_float(random_generator* random, unsigned int bound) {
+	return static_cast<float>(random->next(bound * 100)) / 100.f;
+}
+
+int main() {
+	for (unsigned int num_sheep : {40u, 1000u, 10000u}) {
+		random_generator random(42, num_sheep);
+		sheep_store sheeps;
+		std::vector<float> xs, ys, zs;
+		for (unsigned int i = 0; i < num_sheep; i++) {
+			const glm::vec3 position(random_float(&random, 128), random_float(&random, 10), random_float(&random, 64));
+			sheeps.add(position, 0.f);
+			xs.push_back(position.x);
+			ys.push_back(position.y);
+			zs.push_back(position.z);
+		}
+
+		std::vector<ray> rays;
+		for (unsigned int i = 0; i < NUM_RAYS; i++) {
+			const glm::vec3 position(random_float(&random, 128), random_float(&random, 10), random_float(&random, 64));
+			const glm::vec3 direction(random_float(&random, 2) - 1.f, random_float(&random, 2) - 1.f, random_float(&random, 2) - 1.f);
+			rays.push_back(ray(position, direction + glm::vec3(0.01f, 0.f, 0.f)));
+		}
+
+		unsigned int num_hits = 0;
+		unsigned int num_mismatches = 0;
+
+		auto start = std::chrono::steady_clock::now();
+		std::vector<std::optional<std::size_t>> loop_hits;
+		for (const ray& r : rays) {
+			loop_hits.push_back(single_sheep_loop(sheeps, r, HOOK_RANGE));
+		}
+		auto loop_end = std::chrono::steady_clock::now();
+		std::vector<std::optional<std::size_t>> batch_hits;
+		for (const ray& r : rays) {
+			batch_hits.push_back(find_closest_hit_sphere(r, SHEEP_HIT_RADIUS, HOOK_RANGE, xs.data(), ys.data(), zs.data(), num_sheep));
+		}
+		auto batch_end = std::chrono::steady_clock::now();
+
+		for (unsigned int i = 0; i < NUM_RAYS; i++) {
+			if (loop_hits[i]) num_hits++;
+			if (loop_hits[i] != batch_hits[i]) num_mismatches++;
+		}
+
+		const double loop_us = std::chrono::duration<double, std::micro>(loop_end - start).count() / NUM_RAYS;
+		const double batch_us = std::chrono::duration<double, std::micro>(batch_end - loop_end).count() / NUM_RAYS;
+		std::cout << num_sheep << " sheep" << std::endl;
+		std::cout << "\tsingle: " << loop_us << " us/ray" << std::endl;
+		std::cout << "\tbatch:  " << batch_us << " us/ray speedup=" << loop_us / batch_us
+				  << " hits=" << num_hits << " mismatches=" << num_mismatches << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <common/frame.hpp>
+#include <common/thread_pool.hpp>
+
+constexpr unsigned int MATCH_SEED = 4242;
+// all sheep start in the same state, it takes a few state changes until they spread out
+constexpr unsigned int WARMUP_TICKS = 480;
+constexpr unsigned int MEASURED_TICKS = 100;
+constexpr float DELTA_TIME = 1.f / 60.f;
+
+double measure_tick_milliseconds(unsigned int num_sheep, thread_pool* pool, frame* f) {
+	f->init(MATCH_SEED, num_sheep);
+	f->set_thread_pool(pool);
+
+	for (unsigned int i = 0; i < WARMUP_TICKS; i++) {
+		f->tick(DELTA_TIME);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < MEASURED_TICKS; i++) {
+		f->tick(DELTA_TIME);
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, std::milli>(end - start).count() / MEASURED_TICKS;
+}
+
+bool same_sheep_positions(const frame& a, const frame& b) {
+	for (unsigned int i = 0; i < a.sheeps.size(); i++) {
+		const glm::vec3 pa = a.sheeps[i].get_position();
+		const glm::vec3 pb = b.sheeps[i].get_position();
+		if (std::memcmp(&pa, &pb, sizeof(glm::vec3)) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int main() {
+	const unsigned int max_threads = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<unsigned int> thread_counts = {1};
+	for (unsigned int t = 2; t < max_threads; t *= 2) {
+		thread_counts.push_back(t);
+	}
+	if (max_threads > 1) {
+		thread_counts.push_back(max_threads);
+	}
+
+	for (unsigned int num_sheep : {40u, 1000u, 10000u}) {
+		frame serial_frame;
+		const double serial_ms = measure_tick_milliseconds(num_sheep, nullptr, &serial_frame);
+		std::cout << num_sheep << " sheep" << std::endl;
+		std::cout << "\tserial:    " << serial_ms << " ms/tick"
+				  << " awake=" << serial_frame.sheeps.get_num_awake() << std::endl;
+
+		for (unsigned int num_threads : thread_counts) {
+			thread_pool pool(num_threads);
+			frame parallel_frame;
+			const double parallel_ms = measure_tick_milliseconds(num_sheep, &pool, &parallel_frame);
+			std::cout << "\t" << num_threads << " threads: " << parallel_ms << " ms/tick"
+					  << " speedup=" << serial_ms / parallel_ms
+					  << (same_sheep_positions(serial_frame, parallel_frame) ? "" : " (DIVERGED)") << std::endl;
+		}
+	}
+	return 0;
+}